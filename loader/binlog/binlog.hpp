@@ -0,0 +1,399 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Binary log format shared by the loader and the log decoder.
+ *
+ * A file starts with the magic "GLOG", a version byte and the time the log
+ * was started as microseconds since the epoch. After that it's a list of
+ * records that each start with a RecordType byte:
+ *
+ * - Mod: index, id, name. Defines a mod index used by later logs
+ * - Format: index, format string. Defines a format index used by later logs
+ * - Log: microseconds since the previous log, mod index, severity byte,
+ *   format index and the packed arguments as a string
+ *
+ * Numbers are unsigned LEB128 varints and strings are a varint length
+ * followed by the bytes. Packed arguments are each argument as an ArgType
+ * byte and its raw value, so the thread that logs doesn't have to turn them
+ * into text. Floats are stored as their little-endian bits
+ */
+namespace binlog {
+    constexpr std::string_view MAGIC = "GLOG";
+    constexpr uint8_t VERSION = 2;
+
+    enum class RecordType : uint8_t {
+        Mod = 0,
+        Format = 1,
+        Log = 2,
+    };
+
+    enum class ArgType : uint8_t {
+        // string
+        String = 0,
+        // zigzag encoded varint
+        Signed = 1,
+        // varint
+        Unsigned = 2,
+        // double, printed the way std::ostream prints it
+        Float = 3,
+        // byte, printed as 0 or 1
+        Bool = 4,
+        // byte, printed as is
+        Char = 5,
+        // x and y as floats
+        Point = 6,
+        // width and height as floats
+        Size = 7,
+        // x, y, width and height as floats
+        Rect = 8,
+        // r, g and b bytes
+        Color3B = 9,
+        // r, g, b and a bytes
+        Color4B = 10,
+        // r, g, b and a as floats
+        Color4F = 11,
+        // type name and address
+        Object = 12,
+        // type name, address and the bounding box as a Rect
+        Node = 13,
+        // mod name
+        Mod = 14,
+    };
+
+    inline void writeVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    inline void writeString(std::string& out, std::string_view str) {
+        writeVarint(out, str.size());
+        out += str;
+    }
+
+    template <class T>
+        requires std::is_floating_point_v<T>
+    void writeFloat(std::string& out, T value) {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out.push_back(static_cast<char>(bits >> (i * 8)));
+        }
+    }
+
+    inline std::optional<uint64_t> readVarint(std::string_view& in) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < in.size() && i < 10; i++) {
+            auto byte = static_cast<uint8_t>(in[i]);
+            value |= static_cast<uint64_t>(byte & 0x7f) << (i * 7);
+            if (!(byte & 0x80)) {
+                in.remove_prefix(i + 1);
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    inline std::optional<std::string_view> readString(std::string_view& in) {
+        auto size = readVarint(in);
+        if (!size || *size > in.size()) {
+            return std::nullopt;
+        }
+        auto str = in.substr(0, *size);
+        in.remove_prefix(*size);
+        return str;
+    }
+
+    template <class T>
+        requires std::is_floating_point_v<T>
+    std::optional<T> readFloat(std::string_view& in) {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        if (in.size() < sizeof(T)) {
+            return std::nullopt;
+        }
+        Bits bits = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bits |= static_cast<Bits>(static_cast<uint8_t>(in[i])) << (i * 8);
+        }
+        in.remove_prefix(sizeof(T));
+        T value;
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+
+    /**
+     * Append the shortest text that reads back as the same float, which is 
+     * how fmt prints floats with "{}"
+     */
+    inline void appendFloat(std::string& out, float value) {
+        char buf[32];
+        int digits = 1;
+        for (; digits < 9; digits++) {
+            std::snprintf(buf, sizeof(buf), "%.*e", digits - 1, value);
+            if (std::strtof(buf, nullptr) == value) {
+                break;
+            }
+        }
+        std::snprintf(buf, sizeof(buf), "%.*e", digits - 1, value);
+        std::string_view str = buf;
+        auto e = str.find('e');
+        // like fmt, only big and small numbers are written with an exponent
+        auto exponent = e == str.npos ? 0 : std::atoi(buf + e + 1);
+        if (e == str.npos || exponent < -4 || exponent >= 16) {
+            out += str;
+            return;
+        }
+        if (str.front() == '-') {
+            out.push_back('-');
+            str.remove_prefix(1);
+            e--;
+        }
+        std::string mantissa;
+        for (auto c : str.substr(0, e)) {
+            if (c != '.') {
+                mantissa.push_back(c);
+            }
+        }
+        if (exponent < 0) {
+            out += "0.";
+            out.append(-exponent - 1, '0');
+            out += mantissa;
+        }
+        else if (static_cast<size_t>(exponent) + 1 >= mantissa.size()) {
+            out += mantissa;
+            out.append(exponent + 1 - mantissa.size(), '0');
+        }
+        else {
+            out += mantissa.substr(0, exponent + 1);
+            out.push_back('.');
+            out += mantissa.substr(exponent + 1);
+        }
+    }
+
+    /**
+     * Read one packed argument and append its text to out. Returns false if 
+     * the argument is cut off or of an unknown type
+     */
+    inline bool readArgument(std::string_view& in, std::string& text) {
+        if (in.empty()) {
+            return false;
+        }
+        auto type = static_cast<ArgType>(in.front());
+        in.remove_prefix(1);
+
+        auto floats = [&](size_t count, char const* const* separators) {
+            for (size_t i = 0; i < count; i++) {
+                auto value = readFloat<float>(in);
+                if (!value) {
+                    return false;
+                }
+                appendFloat(text, *value);
+                text += separators[i];
+            }
+            return true;
+        };
+        auto bytes = [&](size_t count, char const* const* separators) {
+            if (in.size() < count) {
+                return false;
+            }
+            for (size_t i = 0; i < count; i++) {
+                text += std::to_string(static_cast<uint8_t>(in[i]));
+                text += separators[i];
+            }
+            in.remove_prefix(count);
+            return true;
+        };
+        auto object = [&]() {
+            auto name = readString(in);
+            auto address = readVarint(in);
+            if (!name || !address) {
+                return false;
+            }
+            // same as geode::utils::intToHex
+            char buf[24];
+            std::snprintf(buf, sizeof(buf), "%#llx", static_cast<unsigned long long>(*address));
+            text += "{ ";
+            text += *name;
+            text += ", ";
+            text += buf;
+            return true;
+        };
+
+        static constexpr char const* POINT[] = { ", ", "" };
+        static constexpr char const* SIZE[] = { " : ", "" };
+        static constexpr char const* RECT[] = { ", ", " | ", " : ", "" };
+        static constexpr char const* COLOR[] = { ", ", ", ", ", ", "" };
+        static constexpr char const* RGB[] = { ", ", ", ", "" };
+        static constexpr char const* NODE[] = { ", ", " | ", " : ", ") }" };
+
+        switch (type) {
+            case ArgType::String: {
+                auto str = readString(in);
+                if (!str) {
+                    return false;
+                }
+                text += *str;
+            } break;
+
+            case ArgType::Signed: {
+                auto value = readVarint(in);
+                if (!value) {
+                    return false;
+                }
+                auto decoded = static_cast<int64_t>(*value >> 1) ^ -static_cast<int64_t>(*value & 1);
+                text += std::to_string(decoded);
+            } break;
+
+            case ArgType::Unsigned: {
+                auto value = readVarint(in);
+                if (!value) {
+                    return false;
+                }
+                text += std::to_string(*value);
+            } break;
+
+            case ArgType::Float: {
+                auto value = readFloat<double>(in);
+                if (!value) {
+                    return false;
+                }
+                char buf[32];
+                std::snprintf(buf, sizeof(buf), "%g", *value);
+                text += buf;
+            } break;
+
+            case ArgType::Bool:
+            case ArgType::Char: {
+                if (in.empty()) {
+                    return false;
+                }
+                text += type == ArgType::Bool ? (in.front() ? "1" : "0") : std::string(1, in.front());
+                in.remove_prefix(1);
+            } break;
+
+            case ArgType::Point: {
+                if (!floats(2, POINT)) {
+                    return false;
+                }
+            } break;
+
+            case ArgType::Size: {
+                if (!floats(2, SIZE)) {
+                    return false;
+                }
+            } break;
+
+            case ArgType::Rect: {
+                if (!floats(4, RECT)) {
+                    return false;
+                }
+            } break;
+
+            case ArgType::Color3B: {
+                text += "rgb(";
+                if (!bytes(3, RGB)) {
+                    return false;
+                }
+                text += ")";
+            } break;
+
+            case ArgType::Color4B: {
+                text += "rgba(";
+                if (!bytes(4, COLOR)) {
+                    return false;
+                }
+                text += ")";
+            } break;
+
+            case ArgType::Color4F: {
+                text += "rgba(";
+                if (!floats(4, COLOR)) {
+                    return false;
+                }
+                text += ")";
+            } break;
+
+            case ArgType::Object: {
+                if (!object()) {
+                    return false;
+                }
+                text += " }";
+            } break;
+
+            case ArgType::Node: {
+                if (!object()) {
+                    return false;
+                }
+                text += ", (";
+                if (!floats(4, NODE)) {
+                    return false;
+                }
+            } break;
+
+            case ArgType::Mod: {
+                auto name = readString(in);
+                if (!name) {
+                    return false;
+                }
+                text += "{ Mod, ";
+                text += *name;
+                text += " }";
+            } break;
+
+            default: return false;
+        }
+        return true;
+    }
+
+    /**
+     * Read packed arguments until the end of the input
+     */
+    inline std::vector<std::string> readArguments(std::string_view in) {
+        std::vector<std::string> args;
+        std::string arg;
+        while (in.size() && readArgument(in, arg)) {
+            args.push_back(std::move(arg));
+            arg.clear();
+        }
+        return args;
+    }
+
+    /**
+     * Put a format string and its arguments together the same way
+     * geode::log::internalLog does. Extra "{}" are left empty
+     */
+    inline std::string format(std::string_view fmt, std::span<std::string const> args) {
+        std::string res;
+        res.reserve(fmt.size());
+        size_t arg = 0;
+        for (size_t i = 0; i < fmt.size(); i++) {
+            auto next = i + 1 < fmt.size() ? fmt[i + 1] : '\0';
+            if (fmt[i] == '{' && next == '}') {
+                if (arg < args.size()) {
+                    res += args[arg++];
+                }
+                i++;
+                continue;
+            }
+            res.push_back(fmt[i]);
+            if ((fmt[i] == '{' || fmt[i] == '}') && next == fmt[i]) {
+                i++;
+            }
+        }
+        return res;
+    }
+}
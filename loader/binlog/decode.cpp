@@ -0,0 +1,139 @@
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#include "binlog.hpp"
+
+static constexpr std::string_view SEVERITIES[] = {
+    "debug", "info", "notice", "warning", "error", "critical", "alert", "emergency",
+};
+
+struct ModInfo {
+    std::string_view id;
+    std::string_view name;
+};
+
+static std::string formatTime(uint64_t micros) {
+    auto time = static_cast<std::time_t>(micros / 1000000);
+    char buf[16];
+    std::strftime(buf, sizeof(buf), "%H:%M:%S", std::localtime(&time));
+    return buf;
+}
+
+int main(int argc, char** argv) {
+    char const* path = nullptr;
+    std::string_view modFilter;
+    size_t minSeverity = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--mod" && i + 1 < argc) {
+            modFilter = argv[++i];
+        }
+        else if (arg == "--severity" && i + 1 < argc) {
+            std::string_view name = argv[++i];
+            minSeverity = std::size(SEVERITIES);
+            for (size_t s = 0; s < std::size(SEVERITIES); s++) {
+                if (SEVERITIES[s] == name) {
+                    minSeverity = s;
+                }
+            }
+            if (minSeverity == std::size(SEVERITIES)) {
+                std::cout << "Unknown severity \"" << name << "\"\n";
+                return 1;
+            }
+        }
+        else if (!path) {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        std::cout << "Usage: \"GeodeLogDecoder <file.glog> [--mod <id>] [--severity <level>]\"\n";
+        return 1;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "Unable to open \"" << path << "\"\n";
+        return 1;
+    }
+    std::stringstream buf;
+    buf << file.rdbuf();
+    auto data = buf.str();
+    std::string_view in = data;
+
+    if (!in.starts_with(binlog::MAGIC) || in.size() < binlog::MAGIC.size() + 1) {
+        std::cout << "Not a Geode binary log\n";
+        return 1;
+    }
+    in.remove_prefix(binlog::MAGIC.size());
+    if (static_cast<uint8_t>(in.front()) != binlog::VERSION) {
+        std::cout << "Unsupported binary log version " << +static_cast<uint8_t>(in.front()) << "\n";
+        return 1;
+    }
+    in.remove_prefix(1);
+    auto time = binlog::readVarint(in);
+
+    std::unordered_map<uint64_t, ModInfo> mods;
+    std::unordered_map<uint64_t, std::string_view> formats;
+    std::vector<std::string> args;
+
+    // a log that was cut off by a crash just ends early
+    while (time && in.size()) {
+        auto type = static_cast<binlog::RecordType>(in.front());
+        in.remove_prefix(1);
+        switch (type) {
+            case binlog::RecordType::Mod: {
+                auto index = binlog::readVarint(in);
+                auto id = binlog::readString(in);
+                auto name = binlog::readString(in);
+                if (!index || !id || !name) {
+                    return 0;
+                }
+                mods[*index] = { *id, *name };
+            } break;
+
+            case binlog::RecordType::Format: {
+                auto index = binlog::readVarint(in);
+                auto format = binlog::readString(in);
+                if (!index || !format) {
+                    return 0;
+                }
+                formats[*index] = *format;
+            } break;
+
+            case binlog::RecordType::Log: {
+                auto delta = binlog::readVarint(in);
+                auto mod = binlog::readVarint(in);
+                if (!delta || !mod || in.empty()) {
+                    return 0;
+                }
+                auto severity = static_cast<uint8_t>(in.front());
+                in.remove_prefix(1);
+                auto format = binlog::readVarint(in);
+                auto packed = binlog::readString(in);
+                if (!format || !packed) {
+                    return 0;
+                }
+                *time += *delta;
+
+                // the arguments are only turned into text for logs that are shown
+                auto const& info = mods[*mod];
+                if (severity < minSeverity || (modFilter.size() && info.id != modFilter)) {
+                    break;
+                }
+                args = binlog::readArguments(*packed);
+                std::cout << formatTime(*time) << " [" << info.name << "]: "
+                    << binlog::format(formats[*format], args) << "\n";
+            } break;
+
+            default: {
+                std::cout << "Unknown record type " << +static_cast<uint8_t>(type) << "\n";
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include "picosha3.h"
 #include "picosha2.h"
 #include <vector>
+#include <optional>
 #include <ghc/filesystem.hpp>
 
 static std::string calculateSHA3_256(ghc::filesystem::path const& path) {
@@ -25,3 +26,79 @@ static std::string calculateSHA256(ghc::filesystem::path const& path) {
 static std::string calculateHash(ghc::filesystem::path const& path) {
     return calculateSHA3_256(path);
 }
+
+/**
+ * Output stream that writes into a file and calculates the SHA3-256 hash of 
+ * everything written to it along the way, so a download can be verified 
+ * without reading the file back from disk
+ */
+class HashingFileSink final : public std::ostream {
+private:
+    class Buf final : public std::streambuf {
+    public:
+        ghc::filesystem::path m_path;
+        std::filebuf m_file;
+        decltype(picosha3::get_sha3_generator<256>()) m_hash;
+        bool m_opened = false;
+
+        bool open() {
+            m_opened = true;
+            return m_file.open(m_path, std::ios::out | std::ios::binary);
+        }
+
+    protected:
+        std::streamsize xsputn(char const* data, std::streamsize size) override {
+            // the file is only opened once data arrives, so a sink that 
+            // never gets written to doesn't truncate the file
+            if (!m_opened && !this->open()) {
+                return 0;
+            }
+            m_hash.process(data, data + size);
+            return m_file.sputn(data, size);
+        }
+
+        int_type overflow(int_type ch) override {
+            if (traits_type::eq_int_type(ch, traits_type::eof())) {
+                return traits_type::not_eof(ch);
+            }
+            auto c = traits_type::to_char_type(ch);
+            return this->xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+        }
+    };
+
+    Buf m_buf;
+    std::optional<std::string> m_result;
+
+public:
+    HashingFileSink(ghc::filesystem::path const& path) : std::ostream(nullptr) {
+        m_buf.m_path = path;
+        this->rdbuf(&m_buf);
+    }
+
+    /**
+     * Close the file and get the hash of the data written. Safe to call 
+     * more than once
+     * @returns Hex string of the hash, same as calculateHash on the file
+     */
+    std::string finish() {
+        if (m_result) {
+            return *m_result;
+        }
+        // nothing was written through this sink; either the download was 
+        // empty, or another sink wrote the file (for example, if the web 
+        // request was joined into an existing one)
+        if (!m_buf.m_opened) {
+            if (ghc::filesystem::exists(m_buf.m_path)) {
+                return *(m_result = calculateHash(m_buf.m_path));
+            }
+            if (!m_buf.open()) {
+                this->setstate(std::ios::failbit);
+            }
+        }
+        if (!m_buf.m_file.close()) {
+            this->setstate(std::ios::failbit);
+        }
+        m_buf.m_hash.finish();
+        return *(m_result = m_buf.m_hash.get_hex_string());
+    }
+};
@@ -6,6 +6,7 @@
 #include "loader/Mod.hpp"
 #include "loader/ModEvent.hpp"
 #include "loader/Setting.hpp"
+#include "loader/SettingEvent.hpp"
 #include "loader/Dirs.hpp"
 
 #include <Geode/DefaultInclude.hpp>
@@ -11,3 +11,4 @@
 #include "utils/general.hpp"
 #include "utils/timer.hpp"
 #include "utils/MiniFunction.hpp"
+#include "utils/InternedString.hpp"
@@ -864,6 +864,13 @@ public:
      * @note Geode addition
      */
     GEODE_DLL std::string getID();
+    /**
+     * Get the string ID of this node without copying it
+     * @returns The ID, or an empty string if the node has no ID. The 
+     * reference stays valid for as long as the program runs
+     * @note Geode addition
+     */
+    GEODE_DLL std::string const& getIDRef();
     /**
      * Set the string ID of this node. String IDs are a Geode addition 
      * that are much safer to use to get nodes than absolute indexes
@@ -985,7 +992,10 @@ public:
      * control how this node is positioned in its parent's Layout, for example 
      * setting the grow size for a flex layout
      * @param options The layout options
-     * @param apply Whether to update the layout of the parent node
+     * @param apply Whether to update the layout of the parent node. The 
+     * update is deferred until before the next frame, so setting the options 
+     * of many children only updates the parent once; call updateLayout on 
+     * the parent if you need the new positions immediately
      * @note Geode addition
      */
     GEODE_DLL void setLayoutOptions(LayoutOptions* options, bool apply = true);
@@ -1750,7 +1760,7 @@ namespace geode {
 		std::string m_targetID;
 	
 	public:
-        ListenerResult handle(utils::MiniFunction<Callback> fn, AttributeSetEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, AttributeSetEvent* event);
 
 		AttributeSetFilter(std::string const& id);
     };
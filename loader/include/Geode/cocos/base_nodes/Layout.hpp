@@ -224,32 +224,44 @@ protected:
     bool m_crossReverse = false;
     bool m_allowCrossAxisOverflow = true;
     bool m_growCrossAxis = false;
+    // hash of the layout's inputs as they were after the last apply, used to 
+    // skip applying the layout again when nothing has changed
+    size_t m_lastLayoutHash = 0;
 
+    struct NodeInfo;
     struct Row;
+    struct FitResult;
     
-    float minScaleForPrio(CCArray* nodes, int prio) const;
-    float maxScaleForPrio(CCArray* nodes, int prio) const;
+    float minScaleForPrio(NodeInfo const* begin, NodeInfo const* end, int prio) const;
+    float maxScaleForPrio(NodeInfo const* begin, NodeInfo const* end, int prio) const;
     bool shouldAutoScale(AxisLayoutOptions const* opts) const;
     bool canTryScalingDown(
-        CCArray* nodes,
+        NodeInfo const* begin, NodeInfo const* end,
         int& prio, float& scale,
         float crossScaleDownFactor,
         std::pair<int, int> const& minMaxPrios
     ) const;
     float nextGap(AxisLayoutOptions const* now, AxisLayoutOptions const* next) const;
-    Row* fitInRow(
-        CCNode* on, CCArray* nodes,
+    Row fitInRow(
+        CCNode* on, std::vector<NodeInfo> const& nodes, size_t begin,
         std::pair<int, int> const& minMaxPrios,
         bool doAutoScale,
         float scale, float squish, int prio
     ) const;
-    void tryFitLayout(
-        CCNode* on, CCArray* nodes,
+    bool fitRows(
+        CCNode* on, std::vector<NodeInfo> const& nodes, std::vector<Row>& rows,
         std::pair<int, int> const& minMaxPrios,
         bool doAutoScale,
         float scale, float squish, int prio,
-        size_t depth
+        FitResult& res
+    ) const;
+    void tryFitLayout(
+        CCNode* on, std::vector<NodeInfo> const& nodes,
+        std::pair<int, int> const& minMaxPrios,
+        bool doAutoScale,
+        float scale, float squish, int prio
     ) const;
+    size_t layoutHash(CCNode* on) const;
 
     AxisLayout(Axis);
 
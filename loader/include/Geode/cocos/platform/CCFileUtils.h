@@ -298,7 +298,8 @@ public:
     void GEODE_DLL addPriorityPath(const char* path);
     /**
      * Update search path order; texture packs are added first, then other  
-     * paths
+     * paths. This also clears the cache of resolved paths, so call it after 
+     * adding files to a search path that may already have been looked up
      * @note Geode addition
      */
     void GEODE_DLL updatePaths();
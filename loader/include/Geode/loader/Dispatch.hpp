@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Event.hpp"
+#include "../utils/InternedString.hpp"
 
 #include <functional>
 #include <string>
@@ -12,18 +13,18 @@ namespace geode {
     template <class... Args>
     class DispatchEvent : public Event {
     protected:
-        std::string m_id;
+        InternedString m_id;
         std::tuple<Args...> m_args;
     
     public:
-        DispatchEvent(std::string const& id, Args... args)
+        DispatchEvent(InternedString id, Args... args)
           : m_id(id), m_args(std::make_tuple(args...)) {}
         
-        std::tuple<Args...> getArgs() const {
+        std::tuple<Args...> const& getArgs() const {
             return m_args;
         }
 
-        std::string getID() const {
+        InternedString getID() const {
             return m_id;
         }
     };
@@ -31,20 +32,20 @@ namespace geode {
     template <class... Args>
     class DispatchFilter : public EventFilter<DispatchEvent<Args...>> {
     protected:
-        std::string m_id;
+        InternedString m_id;
 
     public:
         using Ev = DispatchEvent<Args...>;
         using Callback = ListenerResult(Args...);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, Ev* event) {
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, Ev* event) {
             if (event->getID() == m_id) {
                 return std::apply(fn, event->getArgs());
             }
             return ListenerResult::Propagate;
         }
 
-        DispatchFilter(std::string const& id) : m_id(id) {}
+        DispatchFilter(InternedString id) : m_id(id) {}
         DispatchFilter(DispatchFilter const&) = default;
     };
 }
\ No newline at end of file
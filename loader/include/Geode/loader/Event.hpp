@@ -4,7 +4,10 @@
 #include "../utils/MiniFunction.hpp"
 
 #include <Geode/DefaultInclude.hpp>
+#include <memory>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace geode {
@@ -33,8 +36,16 @@ namespace geode {
     class GEODE_DLL DefaultEventListenerPool : public EventListenerPool {
     protected:
         std::atomic_size_t m_locked = 0;
+        // listeners in order of addition; removed listeners are left as null 
+        // holes until the pool is compacted
         std::vector<EventListenerProtocol*> m_listeners;
-        std::vector<EventListenerProtocol*> m_toAdd;
+        std::unordered_map<EventListenerProtocol*, size_t> m_indices;
+        // number of listeners visible to handle; listeners added while the 
+        // pool is locked are only made visible once it is unlocked
+        size_t m_visible = 0;
+        size_t m_holes = 0;
+
+        void compact();
 
     public:
         bool add(EventListenerProtocol* listener) override;
@@ -42,6 +53,25 @@ namespace geode {
         ListenerResult handle(Event* event) override;
 
         static DefaultEventListenerPool* get();
+
+        /**
+         * Get the pool that holds listeners for a specific event type. Pools 
+         * are keyed by the type's RTTI name so that the same event type maps 
+         * to the same pool across all mod binaries
+         * @param typeName RTTI name of the event type
+         * @param matches Check whether an event can be cast to the event type. 
+         * Posted events are handed to the pools of every type they match, so 
+         * listeners for a base type still receive derived events
+         */
+        static DefaultEventListenerPool* getForType(char const* typeName, bool(*matches)(Event*));
+
+        template <class T>
+        static DefaultEventListenerPool* getForType() {
+            static auto inst = getForType(typeid(T).name(), +[](Event* event) {
+                return cast::typeinfo_cast<T*>(event) != nullptr;
+            });
+            return inst;
+        }
     };
 
     class GEODE_DLL EventListenerProtocol {
@@ -77,12 +107,12 @@ namespace geode {
         using Callback = ListenerResult(T*);
         using Event = T;
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, T* e) {
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, T* e) {
             return fn(e);
         }
 
         EventListenerPool* getPool() const {
-            return DefaultEventListenerPool::get();
+            return DefaultEventListenerPool::getForType<T>();
         }
 
         void setListener(EventListenerProtocol* listener) {
@@ -199,6 +229,13 @@ namespace geode {
         friend EventListenerProtocol;
 
     protected:
+        /**
+         * Get the pool this event is posted to. By default this is 
+         * DefaultEventListenerPool::get(), in which case the event is first 
+         * posted to the pools of every event type it can be cast to, so only 
+         * listeners for those types are visited. Events that override this 
+         * are only posted to the returned pool
+         */
         virtual EventListenerPool* getPool() const;
 
     public:
@@ -212,4 +249,59 @@ namespace geode {
         
         virtual ~Event();
     };
+
+    /**
+     * Queue for posting events from any thread. Queued events are posted in 
+     * one batch on the GD thread every frame
+     */
+    class GEODE_DLL EventQueue final {
+    protected:
+        class Impl;
+        std::unique_ptr<Impl> m_impl;
+
+        EventQueue();
+
+    public:
+        static EventQueue* get();
+        ~EventQueue();
+
+        /**
+         * Queue an event to be posted on the GD thread. Thread-safe
+         * @param event The event to post; the queue takes ownership of it
+         * @param sender The mod to post the event from
+         * @param coalesceKey If not empty, only the latest queued event of the 
+         * same type with the same key is posted when the queue is flushed. 
+         * Useful for progress events where only the newest value matters
+         */
+        void push(std::unique_ptr<Event> event, Mod* sender, std::string const& coalesceKey = "");
+
+        /**
+         * Post every queued event. Only call this from the GD thread
+         */
+        void flush();
+    };
+
+    /**
+     * Post an event on the GD thread on the next frame. Can be called from 
+     * any thread
+     */
+    template <is_event T>
+    void postAsync(T&& event) {
+        EventQueue::get()->push(
+            std::make_unique<std::remove_cvref_t<T>>(std::forward<T>(event)), getMod()
+        );
+    }
+
+    /**
+     * Post an event on the GD thread on the next frame. If multiple events of 
+     * the same type with the same coalesce key are queued before that, only 
+     * the latest one is posted. Can be called from any thread
+     */
+    template <is_event T>
+    void postAsync(T&& event, std::string const& coalesceKey) {
+        EventQueue::get()->push(
+            std::make_unique<std::remove_cvref_t<T>>(std::forward<T>(event)), getMod(),
+            coalesceKey
+        );
+    }
 }
@@ -4,6 +4,8 @@
 #include "../utils/general.hpp"
 #include <json.hpp>
 #include "Tulip.hpp"
+#include <atomic>
+#include <chrono>
 #include <inttypes.h>
 #include <string_view>
 #include <tulip/TulipHook.hpp>
@@ -12,6 +14,46 @@ namespace geode {
     class Mod;
     class Loader;
 
+    /**
+     * Call statistics for a hook, collected when the "Profile Hooks" loader 
+     * setting is enabled. Times are in nanoseconds
+     */
+    struct HookProfile {
+        std::atomic<uint64_t> calls = 0;
+        // time spent in the detour, including everything it calls
+        std::atomic<uint64_t> inclusiveTime = 0;
+        // time spent in the detour, not counting time spent in other profiled 
+        // hooks called from it
+        std::atomic<uint64_t> exclusiveTime = 0;
+
+        // calls and exclusive time per frame, averaged over about the last 
+        // second. Only updated and read on the main thread
+        double recentCallsPerFrame = 0;
+        double recentTimePerFrame = 0;
+        // totals when the recent averages were last updated
+        uint64_t sampledCalls = 0;
+        uint64_t sampledExclusiveTime = 0;
+    };
+
+    /**
+     * Measures a single call to a profiled detour. Scopes on the same thread 
+     * form a stack, so the time of nested hooks is subtracted from the 
+     * exclusive time of the hooks calling them
+     */
+    class GEODE_DLL HookProfileScope final {
+        HookProfile* m_profile;
+        HookProfileScope* m_parent;
+        std::chrono::steady_clock::time_point m_start;
+        uint64_t m_nested = 0;
+
+    public:
+        HookProfileScope(HookProfile* profile);
+        ~HookProfileScope();
+
+        HookProfileScope(HookProfileScope const&) = delete;
+        HookProfileScope& operator=(HookProfileScope const&) = delete;
+    };
+
     class GEODE_DLL Hook {
     private:
         class Impl;
@@ -141,6 +183,28 @@ namespace geode {
          * @param autoEnable Auto enable
          */
         void setAutoEnable(bool autoEnable);
+
+        /**
+         * Set the detour to use instead of the normal one when hook profiling 
+         * is enabled. Modify sets this automatically; the profiled detour 
+         * should wrap the normal detour in a HookProfileScope using the 
+         * profile from Hook::getProfileFor
+         * @param detour The profiled detour
+         */
+        void setProfiledDetour(void* detour);
+
+        /**
+         * Get the call statistics of this hook
+         * @returns The statistics, or nullptr if the hook isn't profiled
+         */
+        HookProfile const* getProfile() const;
+
+        /**
+         * Get the statistics storage of a profiled detour. The returned 
+         * pointer stays valid for the rest of the program
+         * @param detour The profiled detour
+         */
+        static HookProfile* getProfileFor(void* detour);
     };
 
     class GEODE_DLL Patch {
@@ -2,6 +2,7 @@
 
 #include "Event.hpp"
 #include "Loader.hpp"
+#include "../utils/InternedString.hpp"
 #include <json.hpp>
 
 namespace geode {
@@ -30,8 +31,9 @@ namespace geode {
         bool m_replied = false;
     
     public:
-        std::string targetModID;
-        std::string messageID;
+        // empty if no filter uses the ID the message was sent with
+        InternedString targetModID;
+        InternedString messageID;
         std::unique_ptr<json::Value> messageData;
         json::Value& replyData;
 
@@ -52,11 +54,11 @@ namespace geode {
         using Callback = json::Value(IPCEvent*);
 
     protected:
-        std::string m_modID;
-        std::string m_messageID;
+        InternedString m_modID;
+        InternedString m_messageID;
 
     public:
-        ListenerResult handle(utils::MiniFunction<Callback> fn, IPCEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, IPCEvent* event);
 		IPCFilter(
             std::string const& modID,
             std::string const& messageID
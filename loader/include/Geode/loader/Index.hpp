@@ -26,7 +26,7 @@ namespace geode {
 	public:
 		using Callback = void(ModInstallEvent*);
 	
-        ListenerResult handle(utils::MiniFunction<Callback> fn, ModInstallEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, ModInstallEvent* event);
 		ModInstallFilter(std::string const& id);
         ModInstallFilter(ModInstallFilter const&) = default;
 	};
@@ -40,7 +40,7 @@ namespace geode {
     public:
         using Callback = void(IndexUpdateEvent*);
     
-        ListenerResult handle(utils::MiniFunction<Callback> fn, IndexUpdateEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, IndexUpdateEvent* event);
         IndexUpdateFilter();
         IndexUpdateFilter(IndexUpdateFilter const&) = default;
     };
@@ -67,7 +67,18 @@ namespace geode {
         void updateResources();
         void updateResources(bool forceReload);
 
+        /**
+         * Run a function on the GD thread before the next frame. The 
+         * profile-gd-thread-queue setting reports the time taken by functions 
+         * queued through this overload under "unknown"
+         */
         void queueInGDThread(ScheduledFunction func);
+        /**
+         * Run a function on the GD thread before the next frame
+         * @param mod The mod the function is queued by, which the 
+         * profile-gd-thread-queue setting reports the time taken under
+         */
+        void queueInGDThread(ScheduledFunction func, Mod* mod);
         void waitForModsToBeLoaded();
 
         /**
@@ -11,6 +11,18 @@
 #include <sstream>
 #include <vector>
 #include <span>
+#include <optional>
+#include <stdexcept>
+#include <array>
+#include <type_traits>
+
+// follow fmt, which turns consteval off for cross compilation (see 
+// GEODE_DISABLE_FMT_CONSTEVAL). Bad formats then throw at runtime instead
+#ifdef FMT_CONSTEVAL
+    #define GEODE_LOG_CONSTEVAL FMT_CONSTEVAL
+#else
+    #define GEODE_LOG_CONSTEVAL consteval
+#endif
 
 namespace geode {
 #pragma warning(disable : 4251)
@@ -130,6 +142,7 @@ namespace geode {
             inline ~ComponentBase() override {}
 
             inline ComponentBase(T const& item) : m_item(item) {}
+            inline ComponentBase(T&& item) : m_item(std::move(item)) {}
 
             // specialization must implement
             inline std::string _toString() override {
@@ -137,6 +150,11 @@ namespace geode {
             }
         };
 
+        template <>
+        inline std::string ComponentBase<std::string>::_toString() {
+            return m_item;
+        }
+
         // Log
 
         class GEODE_DLL Log final {
@@ -144,13 +162,27 @@ namespace geode {
             log_clock::time_point m_time;
             std::vector<ComponentTrait*> m_components;
             Severity m_severity;
+            std::string_view m_format;
 
             friend class Logger;
         public:
             ~Log();
             Log(Mod* mod, Severity sev);
+            /**
+             * Create a log whose message has already been formatted
+             */
+            Log(Mod* mod, Severity sev, std::string message);
+            /**
+             * Create a log from a format string and its arguments packed with 
+             * packArgument. They're put together when the log is written. 
+             * The format string only has to outlive this Log until it's 
+             * pushed, after which the logger keeps its own copy
+             */
+            Log(Mod* mod, Severity sev, std::string_view format, std::string packedArgs);
+            Log(Log const& l);
             Log(Log&& l) = default;
-            Log& operator=(Log&& l) = default;
+            Log& operator=(Log const& l);
+            Log& operator=(Log&& l);
             bool operator==(Log const& l);
 
             std::string toString(bool logTime = true) const;
@@ -160,17 +192,29 @@ namespace geode {
             Mod* getSender() const;
             Severity getSeverity() const;
 
+            /**
+             * The format string of a log whose arguments are still packed, 
+             * or an empty string if the message has been put together
+             */
+            std::string_view getFormat() const;
+            /**
+             * Put the format string and packed arguments together into the 
+             * message. Does nothing if that has already been done
+             */
+            void unpack();
+
             [[deprecated("Will be removed in next version")]]
             void addFormat(std::string_view formatStr, std::span<ComponentTrait*> comps);
 
             Result<> addFormatNew(std::string_view formatStr, std::span<ComponentTrait*> comps);
         };
 
+        /**
+         * Logs are written to the console and the log file by a background 
+         * thread, so pushing a log is cheap for the thread doing it
+         */
         class GEODE_DLL Logger {
         private:
-            static std::vector<Log>& logs();
-            static std::ofstream& logStream();
-
             Logger() = delete;
             ~Logger() = delete;
 
@@ -180,48 +224,294 @@ namespace geode {
 
             static void push(Log&& log);
 
+            /**
+             * Remove a log from the logs kept in memory
+             * @param log A log returned by list()
+             */
             static void pop(Log* log);
 
+            /**
+             * Get the logs kept in memory. The pointers are only valid until 
+             * the log is dropped from memory, which happens to the oldest 
+             * logs as new ones are written, so prefer listCopies() unless 
+             * you need to pop() logs
+             */
             static std::vector<Log*> list();
+            /**
+             * Get a copy of the logs kept in memory, with their messages put 
+             * together
+             */
+            static std::vector<Log> listCopies();
             static void clear();
+
+            /**
+             * Block until every log pushed so far has been written to the 
+             * console and the log file
+             */
+            static void flush();
+
+            /**
+             * Write every queued log to the log file on the calling thread, 
+             * without waiting for the log thread. Meant for crash handlers, 
+             * where the log thread may never get to run again
+             */
+            static void drain();
+
+            /**
+             * Keep the logs pushed from the calling thread in a buffer 
+             * instead of writing them, until this is called again with null. 
+             * The loader uses this to write what its worker threads logged 
+             * from the main thread, in the same order every time
+             */
+            static void captureThread(std::vector<Log>* buffer);
+
+            /**
+             * Set how many of the most recent logs are kept in memory for 
+             * list(). Defaults to 10000
+             */
+            static void setHistoryLimit(size_t limit);
+            static size_t getHistoryLimit();
+
+            /**
+             * Logs below this severity are dropped before any of their 
+             * arguments are formatted. Defaults to Severity::Debug, and the 
+             * loader sets it from its "log-level" setting
+             */
+            static void setMinSeverity(Severity severity);
+            static Severity getMinSeverity();
+
+            /**
+             * Use a different minimum severity for the logs of one mod, or 
+             * go back to the global one with std::nullopt. The loader sets 
+             * these from its "mod-log-levels" setting
+             * @param modID ID of the mod, so the override applies even if 
+             * the mod isn't loaded yet
+             */
+            static void setMinSeverity(std::string const& modID, std::optional<Severity> severity);
+            /**
+             * The minimum severity for logs from this mod, which is its 
+             * override if it has one and the global one otherwise
+             */
+            static Severity getMinSeverity(Mod* mod);
+
+            /**
+             * Write logs to a compact binary .glog file instead of the text 
+             * log file. The file can be turned back into text with the 
+             * GeodeLogDecoder tool. Logs from before this is turned on are 
+             * moved over from the text log, so a session stays in one file. 
+             * This makes the log file smaller, and the thread doing the 
+             * logging only packs the raw values of the arguments, which are 
+             * turned into text by the log thread if the console is open and 
+             * by the decoder otherwise
+             */
+            static void setBinarySink(bool enabled);
+            static bool hasBinarySink();
         };
 
+        /**
+         * Append an argument to a packed argument list for a binary log. 
+         * Common types are packed as their raw value and only turned into 
+         * text when the log is read, anything else is packed as its parse()
+         */
+        GEODE_DLL void packArgument(std::string& packed, std::string_view arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::CCPoint const& arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::CCSize const& arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::CCRect const& arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::ccColor3B const& arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::ccColor4B const& arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::ccColor4F const& arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::CCNode* arg);
+        GEODE_DLL void packArgument(std::string& packed, cocos2d::CCObject* arg);
+        GEODE_DLL void packArgument(std::string& packed, Mod* arg);
+        GEODE_DLL void packSigned(std::string& packed, int64_t arg);
+        GEODE_DLL void packUnsigned(std::string& packed, uint64_t arg);
+        GEODE_DLL void packFloat(std::string& packed, double arg);
+        GEODE_DLL void packBool(std::string& packed, bool arg);
+        GEODE_DLL void packChar(std::string& packed, char arg);
+
+        template <class T>
+        void packArgument(std::string& packed, T const& arg) {
+            if constexpr (std::is_same_v<T, bool>) {
+                packBool(packed, arg);
+            }
+            else if constexpr (
+                std::is_same_v<T, char> || std::is_same_v<T, signed char> || 
+                std::is_same_v<T, unsigned char>
+            ) {
+                packChar(packed, static_cast<char>(arg));
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                packSigned(packed, arg);
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                packUnsigned(packed, arg);
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                packFloat(packed, static_cast<double>(arg));
+            }
+            else if constexpr (std::is_same_v<T, gd::string>) {
+                packArgument(packed, std::string_view(arg.c_str(), arg.size()));
+            }
+            else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+                packArgument(packed, std::string_view(arg));
+            }
+            // the elements of an array are only listed by parse()
+            else if constexpr (std::is_convertible_v<T, cocos2d::CCArray*>) {
+                packArgument(packed, std::string_view(parse(arg)));
+            }
+            else if constexpr (std::is_convertible_v<T, cocos2d::CCNode*>) {
+                packArgument(packed, static_cast<cocos2d::CCNode*>(arg));
+            }
+            else if constexpr (std::is_convertible_v<T, cocos2d::CCObject*>) {
+                packArgument(packed, static_cast<cocos2d::CCObject*>(arg));
+            }
+            else {
+                packArgument(packed, std::string_view(parse(arg)));
+            }
+        }
+
+        /**
+         * A log format string, checked against its arguments and split into 
+         * literal chunks at compile time. Arguments are inserted with "{}", 
+         * and literal braces are written as "{{" and "}}"
+         */
+        template <class... Args>
+        class LogFormat final {
+        private:
+            struct Chunk {
+                size_t begin;
+                size_t end;
+                bool escaped;
+            };
+
+            std::string_view m_str;
+            std::array<Chunk, sizeof...(Args) + 1> m_chunks {};
+
+            // not constexpr on purpose, so reaching one of these while 
+            // parsing a format string fails compilation with the message
+            static void formatError(char const* msg) {
+                throw std::logic_error(msg);
+            }
+
+        public:
+            template <class S>
+                requires std::convertible_to<S const&, std::string_view>
+            GEODE_LOG_CONSTEVAL LogFormat(S const& str) : m_str(str) {
+                size_t arg = 0;
+                size_t begin = 0;
+                bool escaped = false;
+                for (size_t i = 0; i < m_str.size(); i++) {
+                    auto next = i + 1 < m_str.size() ? m_str[i + 1] : '\0';
+                    if (m_str[i] == '{') {
+                        if (next == '{') {
+                            escaped = true;
+                            i++;
+                        }
+                        else if (next == '}') {
+                            if (arg == sizeof...(Args)) {
+                                formatError("Not enough arguments for format string");
+                            }
+                            m_chunks[arg++] = { begin, i, escaped };
+                            begin = i + 2;
+                            escaped = false;
+                            i++;
+                        }
+                        else {
+                            formatError("Unescaped { in format string");
+                        }
+                    }
+                    else if (m_str[i] == '}') {
+                        if (next != '}') {
+                            formatError("Unescaped } in format string");
+                        }
+                        escaped = true;
+                        i++;
+                    }
+                }
+                if (arg != sizeof...(Args)) {
+                    formatError("Too many arguments for format string");
+                }
+                m_chunks[arg] = { begin, m_str.size(), escaped };
+            }
+
+            std::string_view get() const {
+                return m_str;
+            }
+
+            /**
+             * Append the literal text preceding the argument at index (or 
+             * the trailing text for index == sizeof...(Args)) to out
+             */
+            void appendChunk(std::string& out, size_t index) const {
+                auto const& chunk = m_chunks[index];
+                auto str = m_str.substr(chunk.begin, chunk.end - chunk.begin);
+                if (!chunk.escaped) {
+                    out += str;
+                    return;
+                }
+                // inside a chunk braces only ever come in escaped pairs
+                for (size_t i = 0; i < str.size(); i++) {
+                    out.push_back(str[i]);
+                    if (str[i] == '{' || str[i] == '}') {
+                        i++;
+                    }
+                }
+            }
+        };
+
+        /**
+         * Format string type for the log functions. The arguments are 
+         * non-deduced here so they're only taken from the actual arguments
+         */
+        template <class... Args>
+        using FormatString = LogFormat<std::type_identity_t<Args>...>;
+
         template <typename... Args>
             requires requires(Args... b) {
                 (parse(b), ...);
             }
-        void internalLog(Severity sev, Mod* m, std::string_view formatStr, Args... args) {
-            Log l(m, sev);
-
-            std::array<ComponentTrait*, sizeof...(Args)> comps = { static_cast<ComponentTrait*>(new ComponentBase(args))... };
-            auto res = l.addFormatNew(formatStr, comps);
+        void internalLog(Severity sev, Mod* m, FormatString<Args...> format, Args const&... args) {
+            if (sev < Logger::getMinSeverity(m)) {
+                return;
+            }
 
-            if (res.isErr()) {
-                internalLog(Severity::Warning, getMod(), "Error parsing log format \"{}\": {}", formatStr, res.unwrapErr());
+            // the binary log keeps the format and arguments apart, and they 
+            // are only put together when something needs the text
+            if (Logger::hasBinarySink()) {
+                std::string packed;
+                (packArgument(packed, args), ...);
+                Logger::push(Log(m, sev, format.get(), std::move(packed)));
                 return;
             }
 
-            Logger::push(std::move(l));
+            std::string message;
+            message.reserve(format.get().size() + sizeof...(Args) * 8);
+
+            size_t index = 0;
+            format.appendChunk(message, index++);
+            ((message += parse(args), format.appendChunk(message, index++)), ...);
+
+            Logger::push(Log(m, sev, std::move(message)));
         }
 
         template <typename... Args>
-        void debug(Args... args) {
-            internalLog(Severity::Debug, getMod(), args...);
+        void debug(FormatString<Args...> format, Args const&... args) {
+            internalLog(Severity::Debug, getMod(), format, args...);
         }
 
         template <typename... Args>
-        void info(Args... args) {
-            internalLog(Severity::Info, getMod(), args...);
+        void info(FormatString<Args...> format, Args const&... args) {
+            internalLog(Severity::Info, getMod(), format, args...);
         }
 
         template <typename... Args>
-        void warn(Args... args) {
-            internalLog(Severity::Warning, getMod(), args...);
+        void warn(FormatString<Args...> format, Args const&... args) {
+            internalLog(Severity::Warning, getMod(), format, args...);
         }
 
         template <typename... Args>
-        void error(Args... args) {
-            internalLog(Severity::Error, getMod(), args...);
+        void error(FormatString<Args...> format, Args const&... args) {
+            internalLog(Severity::Error, getMod(), format, args...);
         }
     }
 }
@@ -12,6 +12,7 @@
 
 #include <json.hpp>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <tulip/TulipHook.hpp>
 #include <type_traits>
@@ -34,6 +35,9 @@ namespace geode {
 
     GEODE_HIDDEN Mod* takeNextLoaderMod();
 
+    template <class T>
+    class SettingHandle;
+
     class ModImpl;
 
     /**
@@ -150,6 +154,16 @@ namespace geode {
             return T();
         }
 
+        /**
+         * Get a typed handle to one of this mod's built-in settings. Get the 
+         * handle once and read it in hot code instead of calling 
+         * getSettingValue every time. Defined in SettingEvent.hpp
+         * @param key The setting's key
+         * @see SettingHandle
+         */
+        template <class T>
+        SettingHandle<T> setting(std::string const& key) const;
+
         template <class T>
         T setSettingValue(std::string const& key, T const& value) {
             if (auto sett = this->getSetting(key)) {
@@ -258,6 +272,15 @@ namespace geode {
          */
         Result<> enableHook(Hook* hook);
 
+        /**
+         * Enable many hooks owned by this Mod at once. This is faster than 
+         * enabling them one by one, as the hooked functions are patched in 
+         * address order after all the handlers have been set up
+         * @returns Successful result if all hooks were enabled, errorful 
+         * result otherwise. Hooks that could be enabled stay enabled
+         */
+        Result<> enableHooks(std::span<Hook* const> hooks);
+
         /**
          * Disable a hook owned by this Mod
          * @returns Successful result on success,
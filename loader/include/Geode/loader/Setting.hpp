@@ -5,6 +5,7 @@
 #include "../utils/Result.hpp"
 #include "../utils/file.hpp"
 #include <json.hpp>
+#include <memory>
 #include <optional>
 #include <unordered_set>
 #include <cocos2d.h>
@@ -12,6 +13,10 @@
 #pragma warning(push)
 #pragma warning(disable : 4275)
 
+namespace re2 {
+    class RE2;
+}
+
 namespace geode {
     class SettingNode;
     class SettingValue;
@@ -95,6 +100,11 @@ namespace geode {
          * A regex the string must succesfully match against
          */
         std::optional<std::string> match;
+        /**
+         * The compiled form of match, shared between every setting with the 
+         * same regex. Set by parse
+         */
+        std::shared_ptr<re2::RE2> compiledMatch;
 
         static Result<StringSetting> parse(JsonMaybeObject& obj);
     };
@@ -22,7 +22,7 @@ namespace geode {
     public:
         using Callback = void(SettingValue*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, SettingChangedEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, SettingChangedEvent* event);
         /**
          * Listen to changes on a setting, or all settings
          * @param modID Mod whose settings to listen to
@@ -43,7 +43,7 @@ namespace geode {
     public:
         using Callback = void(T);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, SettingChangedEvent* event) {
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, SettingChangedEvent* event) {
             if (
                 m_modID == event->mod->getID() &&
                 (!m_targetKey || m_targetKey.value() == event->value->getKey())
@@ -76,4 +76,108 @@ namespace geode {
         );
         return std::monostate();
     }
+
+    template <class T>
+    struct SettingForValueType {
+        static_assert(!std::is_same_v<T, T>, "No built-in setting has this value type");
+    };
+
+    template <> struct SettingForValueType<bool> { using Type = BoolSetting; };
+    template <> struct SettingForValueType<int64_t> { using Type = IntSetting; };
+    template <> struct SettingForValueType<double> { using Type = FloatSetting; };
+    template <> struct SettingForValueType<std::string> { using Type = StringSetting; };
+    template <> struct SettingForValueType<ghc::filesystem::path> { using Type = FileSetting; };
+    template <> struct SettingForValueType<cocos2d::ccColor3B> { using Type = ColorSetting; };
+    template <> struct SettingForValueType<cocos2d::ccColor4B> { using Type = ColorAlphaSetting; };
+
+    /**
+     * A typed handle to one of a mod's built-in settings. Get one with 
+     * Mod::setting once and keep it around; reading through it goes 
+     * straight to the setting's value instead of looking the setting up by 
+     * key like Mod::getSettingValue does
+     * @example
+     * static auto speed = Mod::get()->setting<double>("speed");
+     * this->setPosition(this->getPosition() + ccp(speed.get() * dt, 0));
+     */
+    template <class T>
+    class SettingHandle final {
+    public:
+        using ValueType = GeodeSettingValue<typename SettingForValueType<T>::Type>;
+
+    private:
+        ValueType* m_value = nullptr;
+
+        class Filter : public EventFilter<SettingChangedEvent> {
+        protected:
+            SettingValue* m_value;
+
+        public:
+            using Callback = void(T);
+
+            ListenerResult handle(utils::MiniFunctionRef<Callback> fn, SettingChangedEvent* event) {
+                if (event->value == m_value) {
+                    fn(static_cast<ValueType*>(m_value)->getValue());
+                }
+                return ListenerResult::Propagate;
+            }
+
+            Filter(SettingValue* value) : m_value(value) {}
+            Filter(Filter const&) = default;
+        };
+
+    public:
+        SettingHandle() = default;
+        /**
+         * @param value The setting to refer to. If it isn't a built-in 
+         * setting with the value type T, the handle will be invalid
+         */
+        explicit SettingHandle(SettingValue* value)
+          : m_value(cast::typeinfo_cast<ValueType*>(value)) {}
+
+        /**
+         * Whether this handle refers to a setting. Reading an invalid handle 
+         * returns a default-constructed value, and setting it does nothing
+         */
+        bool isValid() const {
+            return m_value;
+        }
+
+        ValueType* getSetting() const {
+            return m_value;
+        }
+
+        T get() const {
+            if (m_value) {
+                return m_value->getValue();
+            }
+            return T();
+        }
+
+        /**
+         * Set the setting's value
+         * @returns The old value
+         */
+        T set(T const& value) {
+            auto old = this->get();
+            if (m_value) {
+                m_value->setValue(value);
+            }
+            return old;
+        }
+
+        /**
+         * Call a function with the new value whenever this setting changes. 
+         * Unlike GeodeSettingChangedFilter, this compares the setting itself 
+         * instead of the mod ID and key
+         * @returns The listener. Delete it to stop listening
+         */
+        EventListener<Filter>* listen(utils::MiniFunction<void(T)> callback) const {
+            return new EventListener<Filter>(callback, Filter(m_value));
+        }
+    };
+
+    template <class T>
+    SettingHandle<T> Mod::setting(std::string const& key) const {
+        return SettingHandle<T>(this->getSetting(key));
+    }
 }
@@ -2,10 +2,12 @@
 #include "../utils/addresser.hpp"
 #include "Traits.hpp"
 #include "../loader/Log.hpp"
+#include "../loader/Hook.hpp"
 
 namespace geode::modifier {
 /**
  * A helper struct that generates a static function that calls the given function.
+ * The profiled variant is used instead when hook profiling is enabled.
  */
 #define GEODE_AS_STATIC_FUNCTION(FunctionName_)                                                   \
     template <class Class2, class FunctionType>                                                   \
@@ -17,6 +19,13 @@ namespace geode::modifier {
             static Return GEODE_CDECL_CALL function(Params... params) {                           \
                 return Class2::FunctionName_(params...);                                          \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiledFunction(Params... params) {                   \
+                static auto profile = Hook::getProfileFor(                                        \
+                    reinterpret_cast<void*>(&profiledFunction)                                    \
+                );                                                                                \
+                HookProfileScope scope(profile);                                                  \
+                return function(params...);                                                       \
+            }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...)> {                                               \
@@ -26,6 +35,13 @@ namespace geode::modifier {
                 );                                                                                \
                 return self2->Class2::FunctionName_(params...);                                   \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiledFunction(Class* self, Params... params) {      \
+                static auto profile = Hook::getProfileFor(                                        \
+                    reinterpret_cast<void*>(&profiledFunction)                                    \
+                );                                                                                \
+                HookProfileScope scope(profile);                                                  \
+                return function(self, params...);                                                 \
+            }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...) const> {                                         \
@@ -35,8 +51,17 @@ namespace geode::modifier {
                 );                                                                                \
                 return self2->Class2::FunctionName_(params...);                                   \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL                                                        \
+            profiledFunction(Class const* self, Params... params) {                               \
+                static auto profile = Hook::getProfileFor(                                        \
+                    reinterpret_cast<void*>(&profiledFunction)                                    \
+                );                                                                                \
+                HookProfileScope scope(profile);                                                  \
+                return function(self, params...);                                                 \
+            }                                                                                     \
         };                                                                                        \
         static constexpr auto value = &Impl<FunctionType>::function;                              \
+        static constexpr auto profiled = &Impl<FunctionType>::profiledFunction;                   \
     };
 
     GEODE_AS_STATIC_FUNCTION(constructor)
@@ -17,32 +17,33 @@ namespace geode {
 }
 
 namespace geode::modifier {
-    class FieldContainer {
+    using FieldConstructor = void(*)(void*);
+    using FieldDestructor = void(*)(void*);
+
+    /**
+     * Holds the fields of a node. All the fields that have been registered 
+     * for a class are laid out in a single block, which is allocated the 
+     * first time any of them is accessed on the node
+     */
+    class GEODE_DLL FieldContainer {
     private:
-        std::vector<void*> m_containedFields;
-        std::vector<utils::MiniFunction<void(void*)>> m_destructorFunctions;
+        struct Block;
+        Block* m_blocks = nullptr;
 
-    public:
-        ~FieldContainer() {
-            for (auto i = 0u; i < m_containedFields.size(); i++) {
-                m_destructorFunctions[i](m_containedFields[i]);
-                operator delete(m_containedFields[i]);
-            }
-        }
+        Block* createBlock(size_t index);
 
-        void* getField(size_t index) {
-            if (m_containedFields.size() <= index) {
-                m_containedFields.push_back(nullptr);
-                m_destructorFunctions.push_back(nullptr);
-            }
-            return m_containedFields.at(index);
-        }
-
-        void* setField(size_t index, size_t size, utils::MiniFunction<void(void*)> destructor) {
-            m_containedFields.at(index) = operator new(size);
-            m_destructorFunctions.at(index) = destructor;
-            return m_containedFields.at(index);
-        }
+    public:
+        FieldContainer() = default;
+        FieldContainer(FieldContainer const&) = delete;
+        FieldContainer& operator=(FieldContainer const&) = delete;
+        ~FieldContainer();
+
+        /**
+         * Get a field, constructing it if this is the first time it's 
+         * accessed on this node
+         * @param index Index of the field returned by registerField
+         */
+        void* getField(size_t index);
 
         static FieldContainer* from(cocos2d::CCNode* node) {
             return node->getFieldContainer();
@@ -51,8 +52,24 @@ namespace geode::modifier {
 
     [[deprecated("Will be removed in 1.0.0")]]
     GEODE_DLL size_t getFieldIndexForClass(size_t hash);
+    [[deprecated("Use registerField")]]
     GEODE_DLL size_t getFieldIndexForClass(char const* name);
 
+    /**
+     * Register the fields of a Modify. The index is global across all mods, 
+     * so this is defined in the loader
+     * @param name Name of the modified class
+     * @param size Size of the fields
+     * @param align Alignment of the fields
+     * @param constructor Constructs the fields in place
+     * @param destructor Destroys the fields in place
+     * @returns Index to pass to FieldContainer::getField
+     */
+    GEODE_DLL size_t registerField(
+        char const* name, size_t size, size_t align,
+        FieldConstructor constructor, FieldDestructor destructor
+    );
+
     template <class Parent, class Base>
     class FieldIntermediate {
         using Intermediate = Modify<Parent, Base>;
@@ -103,18 +120,15 @@ namespace geode::modifier {
 
             // the index is global across all mods, so the
             // function is defined in the loader source
-            static size_t index = getFieldIndexForClass(typeid(Base).name());
+            static size_t index = registerField(
+                typeid(Base).name(),
+                sizeof(Parent) - sizeof(Intermediate), alignof(Parent),
+                &FieldIntermediate::fieldConstructor, &FieldIntermediate::fieldDestructor
+            );
 
             // the fields are actually offset from their original
             // offset, this is done to save on allocation and space
             auto offsetField = container->getField(index);
-            if (!offsetField) {
-                offsetField = container->setField(
-                    index, sizeof(Parent) - sizeof(Intermediate), &FieldIntermediate::fieldDestructor
-                );
-
-                FieldIntermediate::fieldConstructor(offsetField);
-            }
 
             return reinterpret_cast<Parent*>(
                 reinterpret_cast<std::byte*>(offsetField) - sizeof(Intermediate)
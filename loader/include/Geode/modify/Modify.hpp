@@ -28,38 +28,51 @@
                 #ClassName_ "::" #FunctionName_,                                                    \
                 tulip::hook::TulipConvention::Convention_                                           \
             );                                                                                      \
+            hook->setProfiledDetour(reinterpret_cast<void*>(                                        \
+                AsStaticFunction_##FunctionName_<                                                   \
+                    Derived,                                                                        \
+                    decltype(Resolve<__VA_ARGS__>::func(&Derived::FunctionName_))>::profiled        \
+            ));                                                                                     \
             this->m_hooks[#ClassName_ "::" #FunctionName_] = hook;                                  \
         }                                                                                           \
     } while (0);
 
-#define GEODE_APPLY_MODIFY_FOR_CONSTRUCTOR(AddressIndex_, Convention_, ClassName_, ...)  \
-    do {                                                                                 \
-        if constexpr (HasConstructor<Derived>) {                                         \
-            auto hook = Hook::create(                                                    \
-                Mod::get(),                                                              \
-                reinterpret_cast<void*>(address<AddressIndex_>()),                       \
-                AsStaticFunction_##constructor<                                          \
-                    Derived,                                                             \
-                    decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>::value, \
-                #ClassName_ "::" #ClassName_,                                            \
-                tulip::hook::TulipConvention::Convention_                                \
-            );                                                                           \
-            this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                          \
-        }                                                                                \
+#define GEODE_APPLY_MODIFY_FOR_CONSTRUCTOR(AddressIndex_, Convention_, ClassName_, ...)    \
+    do {                                                                                   \
+        if constexpr (HasConstructor<Derived>) {                                           \
+            auto hook = Hook::create(                                                      \
+                Mod::get(),                                                                \
+                reinterpret_cast<void*>(address<AddressIndex_>()),                         \
+                AsStaticFunction_##constructor<                                            \
+                    Derived,                                                               \
+                    decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>::value,   \
+                #ClassName_ "::" #ClassName_,                                              \
+                tulip::hook::TulipConvention::Convention_                                  \
+            );                                                                             \
+            hook->setProfiledDetour(reinterpret_cast<void*>(                               \
+                AsStaticFunction_##constructor<                                            \
+                    Derived,                                                               \
+                    decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>::profiled \
+            ));                                                                            \
+            this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                            \
+        }                                                                                  \
     } while (0);
 
-#define GEODE_APPLY_MODIFY_FOR_DESTRUCTOR(AddressIndex_, Convention_, ClassName_)                               \
-    do {                                                                                                        \
-        if constexpr (HasDestructor<Derived>) {                                                                 \
-            auto hook = Hook::create(                                                                           \
-                Mod::get(),                                                                                     \
-                reinterpret_cast<void*>(address<AddressIndex_>()),                                              \
-                AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>::value, \
-                #ClassName_ "::" #ClassName_,                                                                   \
-                tulip::hook::TulipConvention::Convention_                                                       \
-            );                                                                                                  \
-            this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                                                 \
-        }                                                                                                       \
+#define GEODE_APPLY_MODIFY_FOR_DESTRUCTOR(AddressIndex_, Convention_, ClassName_)                                 \
+    do {                                                                                                          \
+        if constexpr (HasDestructor<Derived>) {                                                                   \
+            auto hook = Hook::create(                                                                             \
+                Mod::get(),                                                                                       \
+                reinterpret_cast<void*>(address<AddressIndex_>()),                                                \
+                AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>::value,   \
+                #ClassName_ "::" #ClassName_,                                                                     \
+                tulip::hook::TulipConvention::Convention_                                                         \
+            );                                                                                                    \
+            hook->setProfiledDetour(reinterpret_cast<void*>(                                                      \
+                AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>::profiled \
+            ));                                                                                                   \
+            this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                                                   \
+        }                                                                                                         \
     } while (0);
 
 namespace geode::modifier {
@@ -35,15 +35,45 @@ namespace geode {
         public cocos2d::CCLabelProtocol,
         public FLAlertLayerProtocol {
     protected:
+        /**
+         * A top-level chunk of the document that can be parsed and laid out 
+         * on its own. Only chunks near the visible area have nodes
+         */
+        struct Block {
+            std::string text;
+            // Offset of the block's top from the top of the content
+            float offset = .0f;
+            // How far below this block's top the next one starts. Negative 
+            // until the block has been measured
+            float height = -1.f;
+            // How far below the block's top its lowest node reaches
+            float depth = .0f;
+            bool laidOut = false;
+            // Owned by m_content
+            std::vector<cocos2d::CCNode*> nodes;
+        };
+
         std::string m_text;
         cocos2d::CCSize m_size;
         cocos2d::extension::CCScale9Sprite* m_bgSprite = nullptr;
         cocos2d::CCMenu* m_content = nullptr;
         CCScrollLayerExt* m_scrollLayer = nullptr;
         TextRenderer* m_renderer = nullptr;
+        std::vector<Block> m_blocks;
+        size_t m_measuredBlocks = 0;
 
         bool init(std::string const& str, cocos2d::CCSize const& size);
 
+        cocos2d::CCNode* renderBlock(Block& block);
+        void placeBlock(Block& block, cocos2d::CCNode* rendered);
+        void releaseBlock(Block& block);
+        bool isBlockNearView(Block const& block);
+        void updateVisibleBlocks();
+        void measureNextBlock();
+        float getMeasuredHeight() const;
+        void setContentHeight(float height);
+        void update(float dt) override;
+
         virtual ~MDTextArea();
 
         void onLink(CCObject*);
@@ -64,7 +94,10 @@ namespace geode {
 
         /**
          * Update the label's content; call
-         * sparingly as rendering may be slow
+         * sparingly as rendering may be slow. Only 
+         * the parts of the document near the visible 
+         * area are rendered, the rest is rendered as 
+         * it's scrolled into view
          */
         void updateLabel();
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../DefaultInclude.hpp"
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace geode {
+    /**
+     * A string that is stored only once in a global table. Interned strings 
+     * are pointer-sized, and copying and comparing two of them only copies 
+     * and compares the pointer, which makes them a good fit for IDs that are 
+     * compared a lot, like event and node IDs. Interned strings are kept 
+     * until the game closes, so use find() for strings that come from 
+     * outside the game instead of interning them
+     */
+    class GEODE_DLL InternedString final {
+    private:
+        // null for the empty string
+        std::string const* m_str = nullptr;
+
+        explicit InternedString(std::string const* str) : m_str(str) {}
+
+    public:
+        InternedString() = default;
+        InternedString(std::string_view str);
+        InternedString(std::string const& str);
+        InternedString(char const* str);
+
+        /**
+         * Get the interned version of a string without adding it to the 
+         * table if it hasn't been interned yet
+         * @returns The interned string, or std::nullopt if the string has 
+         * not been interned, in which case nothing can be equal to it
+         */
+        static std::optional<InternedString> find(std::string_view str);
+
+        std::string const& str() const;
+        char const* c_str() const;
+        size_t size() const;
+
+        bool empty() const {
+            return !m_str;
+        }
+
+        operator std::string const&() const {
+            return this->str();
+        }
+
+        bool operator==(InternedString const& other) const {
+            return m_str == other.m_str;
+        }
+        bool operator==(std::string_view other) const {
+            return std::string_view(this->str()) == other;
+        }
+        bool operator==(std::string const& other) const {
+            return this->str() == other;
+        }
+        bool operator==(char const* other) const {
+            return this->str() == other;
+        }
+
+        size_t hash() const {
+            return std::hash<void const*>()(m_str);
+        }
+    };
+}
+
+namespace std {
+    template <>
+    struct hash<geode::InternedString> {
+        size_t operator()(geode::InternedString const& str) const {
+            return str.hash();
+        }
+    };
+}
@@ -2,6 +2,8 @@
 
 #include <Geode/DefaultInclude.hpp>
 #include <memory>
+#include <cstddef>
+#include <new>
 
 namespace geode::utils {
 
@@ -14,6 +16,8 @@ namespace geode::utils {
         virtual ~MiniFunctionStateBase() = default;
         virtual Ret call(Args... args) const = 0;
         virtual MiniFunctionStateBase* clone() const = 0;
+        virtual MiniFunctionStateBase* cloneInto(void* buffer) const = 0;
+        virtual MiniFunctionStateBase* moveInto(void* buffer) = 0;
     };
 
     template <class Type, class Ret, class... Args>
@@ -30,6 +34,14 @@ namespace geode::utils {
         MiniFunctionStateBase<Ret, Args...>* clone() const override {
             return new MiniFunctionState(*this);
         }
+
+        MiniFunctionStateBase<Ret, Args...>* cloneInto(void* buffer) const override {
+            return new (buffer) MiniFunctionState(*this);
+        }
+
+        MiniFunctionStateBase<Ret, Args...>* moveInto(void* buffer) override {
+            return new (buffer) MiniFunctionState(std::move(*this));
+        }
     };
 
     template <class Type, class Ret, class... Args>
@@ -46,6 +58,14 @@ namespace geode::utils {
         MiniFunctionStateBase<Ret, Args...>* clone() const override {
             return new MiniFunctionStatePointer(*this);
         }
+
+        MiniFunctionStateBase<Ret, Args...>* cloneInto(void* buffer) const override {
+            return new (buffer) MiniFunctionStatePointer(*this);
+        }
+
+        MiniFunctionStateBase<Ret, Args...>* moveInto(void* buffer) override {
+            return new (buffer) MiniFunctionStatePointer(std::move(*this));
+        }
     };
 
     template <class Type, class Ret, class Class, class... Args>
@@ -62,6 +82,14 @@ namespace geode::utils {
         MiniFunctionStateBase<Ret, Class, Args...>* clone() const override {
             return new MiniFunctionStateMemberPointer(*this);
         }
+
+        MiniFunctionStateBase<Ret, Class, Args...>* cloneInto(void* buffer) const override {
+            return new (buffer) MiniFunctionStateMemberPointer(*this);
+        }
+
+        MiniFunctionStateBase<Ret, Class, Args...>* moveInto(void* buffer) override {
+            return new (buffer) MiniFunctionStateMemberPointer(std::move(*this));
+        }
     };
     
     template <class Callable, class Ret, class... Args>
@@ -69,6 +97,13 @@ namespace geode::utils {
         { func(args...) } -> std::same_as<Ret>;
     };
 
+    /**
+     * Owning type-erased callable. Small callables are stored inline, so 
+     * the size of MiniFunction is the inline buffer plus a pointer; this 
+     * changed when the buffer was added, so code passing MiniFunctions 
+     * across binaries (like ScheduledFunction) must be built against the 
+     * same headers
+     */
     template <class Ret, class... Args>
     class MiniFunction<Ret(Args...)> {
     public:
@@ -76,49 +111,112 @@ namespace geode::utils {
         using StateType = MiniFunctionStateBase<Ret, Args...>;
 
     private:
+        // states that fit (function pointers and lambdas with a few 
+        // captures) are stored inline instead of being heap allocated
+        static constexpr size_t BUFFER_SIZE = sizeof(void*) * 4;
+
         StateType* m_state;
+        alignas(void*) std::byte m_buffer[BUFFER_SIZE];
+
+        bool isInline() const {
+            return static_cast<void const*>(m_state) == static_cast<void const*>(m_buffer);
+        }
+
+        template <class State, class... StateArgs>
+        void emplace(StateArgs&&... args) {
+            if constexpr (
+                sizeof(State) <= BUFFER_SIZE && alignof(State) <= alignof(void*) &&
+                std::is_nothrow_move_constructible_v<State>
+            ) {
+                m_state = new (m_buffer) State(std::forward<StateArgs>(args)...);
+            }
+            else {
+                m_state = new State(std::forward<StateArgs>(args)...);
+            }
+        }
+
+        void copyFrom(MiniFunction const& other) {
+            if (!other.m_state) {
+                m_state = nullptr;
+            }
+            else if (other.isInline()) {
+                m_state = other.m_state->cloneInto(m_buffer);
+            }
+            else {
+                m_state = other.m_state->clone();
+            }
+        }
+
+        void moveFrom(MiniFunction& other) {
+            if (other.m_state && other.isInline()) {
+                m_state = other.m_state->moveInto(m_buffer);
+                other.reset();
+            }
+            else {
+                m_state = other.m_state;
+                other.m_state = nullptr;
+            }
+        }
+
+        void reset() {
+            if (!m_state) return;
+            if (this->isInline()) {
+                m_state->~StateType();
+            }
+            else {
+                delete m_state;
+            }
+            m_state = nullptr;
+        }
 
     public:
         MiniFunction() : m_state(nullptr) {}
 
         MiniFunction(std::nullptr_t) : MiniFunction() {}
 
-        MiniFunction(MiniFunction const& other) :
-            m_state(other.m_state ? other.m_state->clone() : nullptr) {}
+        MiniFunction(MiniFunction const& other) {
+            this->copyFrom(other);
+        }
 
-        MiniFunction(MiniFunction&& other) : m_state(other.m_state) {
-            other.m_state = nullptr;
+        MiniFunction(MiniFunction&& other) {
+            this->moveFrom(other);
         }
 
         ~MiniFunction() {
-            delete m_state;
+            this->reset();
         }
 
         template <class Callable>
         requires(MiniFunctionCallable<Callable, Ret, Args...> && !std::is_same_v<std::decay_t<Callable>, MiniFunction<FunctionType>>)
-        MiniFunction(Callable&& func) :
-            m_state(new MiniFunctionState<std::decay_t<Callable>, Ret, Args...>(std::forward<Callable>(func))) {}
+        MiniFunction(Callable&& func) {
+            this->emplace<MiniFunctionState<std::decay_t<Callable>, Ret, Args...>>(std::forward<Callable>(func));
+        }
 
         template <class FunctionPointer> 
         requires(!MiniFunctionCallable<FunctionPointer, Ret, Args...> && std::is_pointer_v<FunctionPointer> && std::is_function_v<std::remove_pointer_t<FunctionPointer>>)
-        MiniFunction(FunctionPointer func) :
-            m_state(new MiniFunctionStatePointer<FunctionPointer, Ret, Args...>(func)) {}
+        MiniFunction(FunctionPointer func) {
+            this->emplace<MiniFunctionStatePointer<FunctionPointer, Ret, Args...>>(func);
+        }
 
         template <class MemberFunctionPointer> 
         requires(std::is_member_function_pointer_v<MemberFunctionPointer>)
-        MiniFunction(MemberFunctionPointer func) :
-            m_state(new MiniFunctionStateMemberPointer<MemberFunctionPointer, Ret, Args...>(func)) {}
+        MiniFunction(MemberFunctionPointer func) {
+            this->emplace<MiniFunctionStateMemberPointer<MemberFunctionPointer, Ret, Args...>>(func);
+        }
 
         MiniFunction& operator=(MiniFunction const& other) {
-            delete m_state;
-            m_state = other.m_state ? other.m_state->clone() : nullptr;
+            if (this != &other) {
+                this->reset();
+                this->copyFrom(other);
+            }
             return *this;
         }
 
         MiniFunction& operator=(MiniFunction&& other) {
-            delete m_state;
-            m_state = other.m_state;
-            other.m_state = nullptr;
+            if (this != &other) {
+                this->reset();
+                this->moveFrom(other);
+            }
             return *this;
         }
 
@@ -131,4 +229,58 @@ namespace geode::utils {
             return m_state;
         }
     };
+
+    template <class FunctionType>
+    class MiniFunctionRef;
+
+    /**
+     * Non-owning reference to a callable. Never allocates, so use this for 
+     * parameters that are only called and not stored. The referenced 
+     * callable must outlive the MiniFunctionRef
+     */
+    template <class Ret, class... Args>
+    class MiniFunctionRef<Ret(Args...)> {
+    private:
+        union {
+            void* m_object;
+            Ret(*m_function)(Args...);
+        };
+        Ret(*m_call)(MiniFunctionRef const*, Args...);
+
+    public:
+        MiniFunctionRef() : m_object(nullptr), m_call(nullptr) {}
+
+        MiniFunctionRef(std::nullptr_t) : MiniFunctionRef() {}
+
+        MiniFunctionRef(Ret(*func)(Args...)) : m_function(func), m_call(nullptr) {
+            if (func) {
+                m_call = +[](MiniFunctionRef const* self, Args... args) -> Ret {
+                    return self->m_function(std::forward<Args>(args)...);
+                };
+            }
+        }
+
+        template <class Callable>
+        requires(
+            std::is_invocable_r_v<Ret, Callable&, Args...> &&
+            !std::is_same_v<std::decay_t<Callable>, MiniFunctionRef> &&
+            std::is_class_v<std::remove_cvref_t<Callable>>
+        )
+        MiniFunctionRef(Callable&& func) :
+            m_object(const_cast<void*>(static_cast<void const*>(std::addressof(func)))),
+            m_call(+[](MiniFunctionRef const* self, Args... args) -> Ret {
+                return (*static_cast<std::remove_reference_t<Callable>*>(self->m_object))(
+                    std::forward<Args>(args)...
+                );
+            }) {}
+
+        Ret operator()(Args... args) const {
+            if (!m_call) return Ret();
+            return m_call(this, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const {
+            return m_call;
+        }
+    };
 }
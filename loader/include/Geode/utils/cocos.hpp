@@ -5,7 +5,9 @@
 #include "general.hpp"
 #include "../DefaultInclude.hpp"
 #include <cocos2d.h>
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <type_traits>
 #include "../loader/Event.hpp"
 #include "MiniFunction.hpp"
@@ -358,9 +360,15 @@ namespace geode {
 
     class WeakRefPool;
 
-    class GEODE_DLL WeakRefController final {
+    class GEODE_DLL WeakRefController final : 
+        public std::enable_shared_from_this<WeakRefController>
+    {
     private:
-        cocos2d::CCObject* m_obj;
+        // cleared by WeakRefPool::forget, which may run on any thread
+        std::atomic<cocos2d::CCObject*> m_obj = nullptr;
+        // whether the pool holds a reference to the object, which it does 
+        // when the CCObject destructor can't be hooked on this platform
+        bool m_retained = false;
 
         WeakRefController(WeakRefController const&) = delete;
         WeakRefController(WeakRefController&&) = delete;
@@ -370,15 +378,40 @@ namespace geode {
     public:
         WeakRefController() = default;
         
+        /**
+         * Check if the object is still alive. If the pool retains the 
+         * object, it's released here once only the pool references it
+         */
         bool isManaged();
+        /**
+         * Point this controller, and so every WeakRef sharing it, to another 
+         * object
+         * @deprecated Use WeakRef::swap, which only repoints one WeakRef
+         */
+        [[deprecated("Use WeakRef::swap instead")]]
         void swap(cocos2d::CCObject* other);
         cocos2d::CCObject* get() const;
     };
 
     class GEODE_DLL WeakRefPool final {
+        // Objects don't have anywhere to store their own control block, so 
+        // the controllers are kept in a side table. Where the CCObject 
+        // destructor is hooked, entries are removed when their object is 
+        // destroyed and nothing is retained. Elsewhere, the pool retains the 
+        // object until only the pool references it, like Ref would
         std::unordered_map<cocos2d::CCObject*, std::shared_ptr<WeakRefController>> m_pool;
-    
+        // controllers moved to an object that already had one through the 
+        // deprecated WeakRefController::swap
+        std::unordered_multimap<cocos2d::CCObject*, std::shared_ptr<WeakRefController>> m_swapped;
+        // objects can be destroyed on any thread
+        std::mutex m_mutex;
+        // lets forget skip the lock when nothing is weakly referenced
+        std::atomic_size_t m_size = 0;
+
+        // release obj if the pool retains it and is the only one referencing 
+        // it, invalidating its WeakRefs
         void check(cocos2d::CCObject* obj);
+        void repoint(WeakRefController* controller, cocos2d::CCObject* obj);
 
         friend class WeakRefController;
 
@@ -386,6 +419,12 @@ namespace geode {
         static WeakRefPool* get();
         
         std::shared_ptr<WeakRefController> manage(cocos2d::CCObject* obj);
+
+        /**
+         * Invalidate all weak references to an object. Called by the CCObject 
+         * destructor hook
+         */
+        void forget(cocos2d::CCObject* obj);
     };
 
     /**
@@ -398,11 +437,13 @@ namespace geode {
      * the pointer is still valid or not, as WeakRef::lock() returns nullptr if 
      * the pointed-to-object has already been freed.
      *
-     * Note that an object pointed to by WeakRef is only released once some 
+     * On platforms where the CCObject destructor is hooked, WeakRef doesn't 
+     * retain the object, and all WeakRefs pointing to it are invalidated 
+     * when it's destroyed. Elsewhere, the object is only released once some 
      * WeakRef pointing to it checks for it after all other references to the 
      * object have been dropped. If you store WeakRefs in a global map, you may 
-     * want to periodically lock all of them to make sure any memory that should 
-     * be freed is freed.
+     * want to periodically lock all of them to make sure any memory that 
+     * should be freed is freed.
      * 
      * @tparam T A type that inherits from CCObject.
      */
@@ -422,9 +463,7 @@ namespace geode {
          * Construct a WeakRef of an object. A weak reference is one that will 
          * be valid as long as the object is referenced by other strong 
          * references (such as Ref or manual retain calls), but once all strong 
-         * references are dropped, so are all weak references. The object is 
-         * freed once no strong references exist to it, and any WeakRef pointing 
-         * to it is freed or locked
+         * references are dropped, so are all weak references
          * @param obj Object to construct the WeakRef from
          */
         WeakRef(T* obj) : m_controller(WeakRefPool::get()->manage(obj)) {}
@@ -440,7 +479,9 @@ namespace geode {
          */
         WeakRef() = default;
         ~WeakRef() {
-            // If the WeakRef is moved, m_controller is null
+            // lets the pool release the object if it's retaining it and this 
+            // was the last reference. If the WeakRef is moved, m_controller 
+            // is null
             if (m_controller) {
                 m_controller->isManaged();
             }
@@ -451,8 +492,8 @@ namespace geode {
          * a null Ref if the object has been freed
          */
         Ref<T> lock() const {
-            if (m_controller->isManaged()) {
-                return Ref(static_cast<T*>(m_controller->get()));
+            if (this->valid()) {
+                return Ref<T>(this->get());
             }
             return Ref<T>(nullptr);
         }
@@ -461,16 +502,16 @@ namespace geode {
          * Check if the WeakRef points to a valid object
          */
         bool valid() const {
-            return m_controller->isManaged();
+            return m_controller && m_controller->isManaged();
         }
 
         /**
-         * Swap the managed object with another object. The managed object
-         * will be released, and the new object retained
-         * @param other The new object to swap to
+         * Make this WeakRef point to another object. Other WeakRefs pointing 
+         * to the previous object are not affected
+         * @param other The new object to point to
          */
         void swap(T* other) {
-            m_controller->swap(other);
+            m_controller = WeakRefPool::get()->manage(other);
         }
 
         Ref<T> operator=(T* obj) {
@@ -479,12 +520,12 @@ namespace geode {
         }
 
         WeakRef<T>& operator=(WeakRef<T> const& other) {
-            this->swap(static_cast<T*>(other.m_controller->get()));
+            m_controller = other.m_controller;
             return *this;
         }
 
         WeakRef<T>& operator=(WeakRef<T>&& other) {
-            this->swap(static_cast<T*>(other.m_controller->get()));
+            m_controller = std::move(other.m_controller);
             return *this;
         }
 
@@ -493,33 +534,38 @@ namespace geode {
         }
 
         bool operator==(T* other) const {
-            return m_controller->get() == other;
+            return this->get() == other;
         }
 
         bool operator==(WeakRef<T> const& other) const {
-            return m_controller->get() == other.m_controller->get();
+            return this->get() == other.get();
         }
 
         bool operator!=(T* other) const {
-            return m_controller->get() != other;
+            return this->get() != other;
         }
 
         bool operator!=(WeakRef<T> const& other) const {
-            return m_controller->get() != other.m_controller->get();
+            return this->get() != other.get();
         }
 
         // for containers
         bool operator<(WeakRef<T> const& other) const {
-            return m_controller->get() < other.m_controller->get();
+            return this->get() < other.get();
         }
         bool operator<=(WeakRef<T> const& other) const {
-            return m_controller->get() <= other.m_controller->get();
+            return this->get() <= other.get();
         }
         bool operator>(WeakRef<T> const& other) const {
-            return m_controller->get() > other.m_controller->get();
+            return this->get() > other.get();
         }
         bool operator>=(WeakRef<T> const& other) const {
-            return m_controller->get() >= other.m_controller->get();
+            return this->get() >= other.get();
+        }
+
+    private:
+        T* get() const {
+            return m_controller ? static_cast<T*>(m_controller->get()) : nullptr;
         }
     };
 
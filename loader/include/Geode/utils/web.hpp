@@ -54,6 +54,7 @@ namespace geode::utils::web {
     class AsyncWebResult;
     class AsyncWebResponse;
     class AsyncWebRequest;
+    class WebThread;
 
     using AsyncProgress = utils::MiniFunction<void(SentAsyncWebRequest&, double, double)>;
     using AsyncExpect = utils::MiniFunction<void(std::string const&)>;
@@ -73,6 +74,7 @@ namespace geode::utils::web {
         template <class T>
         friend class AsyncWebResult;
         friend class AsyncWebRequest;
+        friend class WebThread;
 
         void pause();
         void resume();
@@ -101,6 +103,15 @@ namespace geode::utils::web {
 
     using SentAsyncWebRequestHandle = std::shared_ptr<SentAsyncWebRequest>;
 
+    /**
+     * Set how many asynchronous web requests may be transferring at once. 
+     * All requests share a single background thread and reuse connections 
+     * to the same host; requests over the limit wait for an earlier one to 
+     * finish. Defaults to 6
+     * @param count Maximum number of simultaneous requests, at least 1
+     */
+    GEODE_DLL void setMaxConcurrentRequests(size_t count);
+
     template <class T>
     using DataConverter = Result<T> (*)(ByteVector const&);
 
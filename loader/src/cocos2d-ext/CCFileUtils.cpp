@@ -2,6 +2,10 @@
 #include <Geode/modify/CCFileUtils.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <cocos2d.h>
+#include <chrono>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace geode::prelude;
 
@@ -9,6 +13,32 @@ static std::vector<CCTexturePack> PACKS;
 static std::vector<std::string> PATHS;
 static bool DONT_ADD_PATHS = false;
 
+struct ResolvedPath {
+    std::string path;
+    // when the file was last found missing, misses are looked up again after 
+    // MISSED_PATH_RETRY in case the file has been created since
+    std::optional<std::chrono::steady_clock::time_point> missedAt;
+};
+
+static constexpr auto MISSED_PATH_RETRY = std::chrono::seconds(1);
+
+// Results of fullPathForFilename, indexed by the value of its second 
+// parameter. Cleared by everything that changes the search paths, the 
+// resolution order or cocos' own cache. Files are looked up from the loading 
+// thread too, so this is guarded by RESOLVED_PATHS_MUTEX
+static std::unordered_map<std::string, ResolvedPath> RESOLVED_PATHS[2];
+static std::shared_mutex RESOLVED_PATHS_MUTEX;
+// bumped on every clear so lookups that raced with one don't store what they 
+// found with the old paths
+static size_t RESOLVED_PATHS_GENERATION = 0;
+
+static void clearResolvedPaths() {
+    std::unique_lock lock(RESOLVED_PATHS_MUTEX);
+    RESOLVED_PATHS[0].clear();
+    RESOLVED_PATHS[1].clear();
+    RESOLVED_PATHS_GENERATION += 1;
+}
+
 #pragma warning(push)
 #pragma warning(disable : 4273)
 
@@ -78,6 +108,9 @@ void CCFileUtils::updatePaths() {
         this->addSearchPath(path.c_str());
     }
     DONT_ADD_PATHS = false;
+
+    // in case nothing was added back
+    clearResolvedPaths();
 }
 
 #pragma warning(pop)
@@ -94,3 +127,75 @@ struct FileUtilsUpdatePaths : Modify<FileUtilsUpdatePaths, CCFileUtils> {
         return ret;
     }
 };
+
+struct FileUtilsResolvedPaths : Modify<FileUtilsResolvedPaths, CCFileUtils> {
+    gd::string fullPathForFilename(char const* filename, bool unk) {
+        if (!filename) {
+            return CCFileUtils::fullPathForFilename(filename, unk);
+        }
+        auto& cache = RESOLVED_PATHS[unk];
+        size_t generation;
+        {
+            std::shared_lock lock(RESOLVED_PATHS_MUTEX);
+            auto it = cache.find(filename);
+            if (it != cache.end() && (
+                !it->second.missedAt ||
+                std::chrono::steady_clock::now() - *it->second.missedAt < MISSED_PATH_RETRY
+            )) {
+                return it->second.path;
+            }
+            generation = RESOLVED_PATHS_GENERATION;
+        }
+
+        // misses resolve to the filename itself
+        std::string path = CCFileUtils::fullPathForFilename(filename, unk);
+        ResolvedPath resolved { .path = path };
+        if (path == filename) {
+            resolved.missedAt = std::chrono::steady_clock::now();
+        }
+
+        std::unique_lock lock(RESOLVED_PATHS_MUTEX);
+        if (generation == RESOLVED_PATHS_GENERATION) {
+            cache.insert_or_assign(filename, std::move(resolved));
+        }
+        return path;
+    }
+
+    // the cache is cleared after the change, so lookups made during it aren't 
+    // kept
+
+    void addSearchPath(char const* path) {
+        CCFileUtils::addSearchPath(path);
+        clearResolvedPaths();
+    }
+
+    void removeSearchPath(char const* path) {
+        CCFileUtils::removeSearchPath(path);
+        clearResolvedPaths();
+    }
+
+    void removeAllPaths() {
+        CCFileUtils::removeAllPaths();
+        clearResolvedPaths();
+    }
+
+    void setSearchPaths(gd::vector<gd::string> const& searchPaths) {
+        CCFileUtils::setSearchPaths(searchPaths);
+        clearResolvedPaths();
+    }
+
+    void setSearchResolutionsOrder(gd::vector<gd::string> const& searchResolutionsOrder) {
+        CCFileUtils::setSearchResolutionsOrder(searchResolutionsOrder);
+        clearResolvedPaths();
+    }
+
+    void addSearchResolutionsOrder(char const* order) {
+        CCFileUtils::addSearchResolutionsOrder(order);
+        clearResolvedPaths();
+    }
+
+    void purgeCachedEntries() {
+        CCFileUtils::purgeCachedEntries();
+        clearResolvedPaths();
+    }
+};
@@ -138,15 +138,43 @@ static float scaleByOpts(AxisLayoutOptions const* opts, float scale, int prio, b
     }
 }
 
-struct AxisLayout::Row : public CCObject {
+// Everything the solver needs to know about a node, measured once per layout 
+// so that fitting rows doesn't need to touch the node itself
+struct AxisLayout::NodeInfo {
+    CCNode* node;
+    AxisLayoutOptions const* opts;
+    // the node's scaled content size, or the off button's size for 
+    // CCMenuItemToggler and zero for SpacerNode
+    CCSize size;
+    // whether the layout's scale applies to size
+    bool scalable;
+    CCPoint anchor;
+    float scaledWidth;
+    std::optional<float> length;
+    bool autoScale;
+
+    CCSize sizeAt(float scale) const {
+        return scalable ? size * scale : size;
+    }
+};
+
+struct AxisLayout::FitResult {
+    float maxRowAxisLength = 0.f;
+    float totalRowCrossLength = 0.f;
+    float crossScaleDownFactor = 0.f;
+    float crossSquishFactor = 0.f;
+};
+
+struct AxisLayout::Row {
     float nextOverflowScaleDownFactor;
     float nextOverflowSquishFactor;
     float axisLength;
     float crossLength;
     float axisEndsLength;
 
-    // all layout calculations happen within a single frame so no Ref needed
-    CCArray* nodes;
+    // the row's nodes are nodes[begin..end) in the list passed to the solver
+    size_t begin;
+    size_t end;
 
     // calculated values for scale, squish and prio to fit the nodes in this 
     // row when positioning
@@ -154,49 +182,24 @@ struct AxisLayout::Row : public CCObject {
     float squish;
     float prio;
 
-    Row(
-        float scaleFactor,
-        float squishFactor,
-        float axisLength,
-        float crossLength,
-        float axisEndsLength,
-        CCArray* nodes,
-        float scale,
-        float squish,
-        float prio
-    ) : nextOverflowScaleDownFactor(scaleFactor),
-        nextOverflowSquishFactor(squishFactor),
-        axisLength(axisLength),
-        crossLength(crossLength),
-        axisEndsLength(axisEndsLength),
-        nodes(nodes),
-        scale(scale),
-        squish(squish),
-        prio(prio)
-    {
-        this->autorelease();
-    }
-
-    void accountSpacers(Axis axis, float availableLength) {
-        std::vector<SpacerNode*> spacers;
-        for (auto& node : CCArrayExt<CCNode>(nodes)) {
-            if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
-                spacers.push_back(spacer);
+    void accountSpacers(Axis axis, float availableLength, NodeInfo const* nodes) {
+        size_t sum = 0;
+        for (auto i = begin; i < end; i++) {
+            if (auto spacer = typeinfo_cast<SpacerNode*>(nodes[i].node)) {
+                sum += spacer->getGrow();
             }
         }
-        if (spacers.size()) {
+        if (sum) {
             auto unusedSpace = availableLength - this->axisLength;
-            size_t sum = 0;
-            for (auto& spacer : spacers) {
-                sum += spacer->getGrow();
-            }
-            for (auto& spacer : spacers) {
-                auto size = unusedSpace * spacer->getGrow() / static_cast<float>(sum);
-                if (axis == Axis::Row) {
-                    spacer->setContentSize({ size, this->crossLength });
-                }
-                else {
-                    spacer->setContentSize({ this->crossLength, size });
+            for (auto i = begin; i < end; i++) {
+                if (auto spacer = typeinfo_cast<SpacerNode*>(nodes[i].node)) {
+                    auto size = unusedSpace * spacer->getGrow() / static_cast<float>(sum);
+                    if (axis == Axis::Row) {
+                        spacer->setContentSize({ size, this->crossLength });
+                    }
+                    else {
+                        spacer->setContentSize({ this->crossLength, size });
+                    }
                 }
             }
             this->axisLength = availableLength;
@@ -211,23 +214,10 @@ struct AxisPosition {
     float crossAnchor;
 };
 
-static AxisPosition nodeAxis(CCNode* node, Axis axis, float scale) {
-    auto scaledSize = node->getScaledContentSize() * scale;
-    std::optional<float> axisLength = std::nullopt;
-    if (auto opts = axisOpts(node)) {
-        axisLength = opts->getLength();
-    }
-    // CCMenuItemToggler is a common quirky class
-    if (auto toggle = typeinfo_cast<CCMenuItemToggler*>(node)) {
-        scaledSize = toggle->m_offButton->getScaledContentSize();
-    }
-    if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
-        scaledSize = CCSizeZero;
-    }
-    auto anchor = node->getAnchorPoint();
+static AxisPosition nodeAxis(CCSize const& scaledSize, CCPoint const& anchor, std::optional<float> length, Axis axis) {
     if (axis == Axis::Row) {
         return AxisPosition {
-            .axisLength = axisLength.value_or(scaledSize.width),
+            .axisLength = length.value_or(scaledSize.width),
             .axisAnchor = anchor.x,
             .crossLength = scaledSize.height,
             .crossAnchor = anchor.y,
@@ -235,7 +225,7 @@ static AxisPosition nodeAxis(CCNode* node, Axis axis, float scale) {
     }
     else {
         return AxisPosition {
-            .axisLength = axisLength.value_or(scaledSize.height),
+            .axisLength = length.value_or(scaledSize.height),
             .axisAnchor = anchor.y,
             .crossLength = scaledSize.width,
             .crossAnchor = anchor.x,
@@ -243,6 +233,22 @@ static AxisPosition nodeAxis(CCNode* node, Axis axis, float scale) {
     }
 }
 
+static AxisPosition nodeAxis(CCNode* node, Axis axis, float scale) {
+    auto scaledSize = node->getScaledContentSize() * scale;
+    std::optional<float> axisLength = std::nullopt;
+    if (auto opts = axisOpts(node)) {
+        axisLength = opts->getLength();
+    }
+    // CCMenuItemToggler is a common quirky class
+    if (auto toggle = typeinfo_cast<CCMenuItemToggler*>(node)) {
+        scaledSize = toggle->m_offButton->getScaledContentSize();
+    }
+    if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
+        scaledSize = CCSizeZero;
+    }
+    return nodeAxis(scaledSize, node->getAnchorPoint(), axisLength, axis);
+}
+
 float AxisLayout::nextGap(AxisLayoutOptions const* now, AxisLayoutOptions const* next) const {
     std::optional<float> gap;
     if (now) {
@@ -259,11 +265,11 @@ bool AxisLayout::shouldAutoScale(AxisLayoutOptions const* opts) const {
     return opts->getAutoScale().value_or(m_autoScale);
 }
 
-float AxisLayout::minScaleForPrio(CCArray* nodes, int prio) const {
+float AxisLayout::minScaleForPrio(NodeInfo const* begin, NodeInfo const* end, int prio) const {
     float min = AXISLAYOUT_DEFAULT_MIN_SCALE;
     bool first = true;
-    for (auto node : CCArrayExt<CCNode>(nodes)) {
-        auto scale = optsMinScale(axisOpts(node));
+    for (auto node = begin; node != end; node++) {
+        auto scale = optsMinScale(node->opts);
         if (first) {
             min = scale;
             first = false;
@@ -275,11 +281,11 @@ float AxisLayout::minScaleForPrio(CCArray* nodes, int prio) const {
     return min;
 }
 
-float AxisLayout::maxScaleForPrio(CCArray* nodes, int prio) const {
+float AxisLayout::maxScaleForPrio(NodeInfo const* begin, NodeInfo const* end, int prio) const {
     float max = 1.f;
     bool first = true;
-    for (auto node : CCArrayExt<CCNode>(nodes)) {
-        auto scale = optsMaxScale(axisOpts(node));
+    for (auto node = begin; node != end; node++) {
+        auto scale = optsMaxScale(node->opts);
         if (first) {
             max = scale;
             first = false;
@@ -291,8 +297,8 @@ float AxisLayout::maxScaleForPrio(CCArray* nodes, int prio) const {
     return max;
 }
 
-AxisLayout::Row* AxisLayout::fitInRow(
-    CCNode* on, CCArray* nodes,
+AxisLayout::Row AxisLayout::fitInRow(
+    CCNode* on, std::vector<NodeInfo> const& nodes, size_t begin,
     std::pair<int, int> const& minMaxPrios,
     bool doAutoScale,
     float scale, float squish, int prio
@@ -302,11 +308,11 @@ AxisLayout::Row* AxisLayout::fitInRow(
     float axisUnsquishedLength;
     float axisLength;
     float crossLength;
-    auto res = CCArray::create();
+    size_t end = nodes.size();
 
     auto available = nodeAxis(on, m_axis, 1.f / on->getScale());
 
-    auto fit = [&](CCArray* nodes) {
+    auto fit = [&](size_t count, float scale, float squish, int prio) {
         nextAxisScalableLength = 0.f;
         nextAxisUnscalableLength = 0.f;
         axisUnsquishedLength = 0.f;
@@ -314,14 +320,16 @@ AxisLayout::Row* AxisLayout::fitInRow(
         crossLength = 0.f;
         AxisLayoutOptions const* prev = nullptr;
         size_t ix = 0;
-        for (auto& node : CCArrayExt<CCNode*>(nodes)) {
-            auto opts = axisOpts(node);
-            if (this->shouldAutoScale(opts)) {
-                node->setScale(1.f);
-            }
+        for (; ix < count; ix++) {
+            auto const& node = nodes[begin + ix];
+            auto opts = node.opts;
             auto nodeScale = scaleByOpts(opts, scale, prio, false);
-            auto pos = nodeAxis(node, m_axis, nodeScale * squish);
-            auto squishPos = nodeAxis(node, m_axis, scaleByOpts(opts, scale, prio, true));
+            auto pos = nodeAxis(
+                node.sizeAt(nodeScale * squish), node.anchor, node.length, m_axis
+            );
+            auto squishPos = nodeAxis(
+                node.sizeAt(scaleByOpts(opts, scale, prio, true)), node.anchor, node.length, m_axis
+            );
             if (prio == optsScalePrio(opts)) {
                 nextAxisScalableLength += pos.axisLength;
             }
@@ -340,9 +348,6 @@ AxisLayout::Row* AxisLayout::fitInRow(
             ) {
                 break;
             }
-            if (nodes != res) {
-                res->addObject(node);
-            }
             if (ix) {
                 auto gap = nextGap(prev, opts);
                 // if we've exhausted all priority scale options, scale gap too
@@ -365,81 +370,110 @@ AxisLayout::Row* AxisLayout::fitInRow(
             }
             prev = opts;
             if (m_growCrossAxis && isOptsBreakLine(opts)) {
+                ix++;
                 break;
             }
-            ix++;
         }
+        return ix;
     };
 
-    fit(nodes);
-
-    // whoops! removing objects from a CCArray while iterating is totes potes UB
-    for (int i = 0; i < res->count(); i++) {
-        nodes->removeFirstObject();
-    }
+    end = begin + fit(end - begin, scale, squish, prio);
+    auto count = end - begin;
+    auto rowBegin = nodes.data() + begin;
+    auto rowEnd = nodes.data() + end;
 
-    // todo: make this calculation more smart to avoid so much unnecessary recursion
     auto scaleDownFactor = scale - .0125f;
     auto squishFactor = available.axisLength / (axisUnsquishedLength + .01f) * squish;
 
     // calculate row scale, squish, and prio
     int tries = 1000;
     while (axisLength > available.axisLength) {
-        if (this->canTryScalingDown(
-            res, prio, scale, scale - .0125f, minMaxPrios
+        auto minScale = this->minScaleForPrio(rowBegin, rowEnd, prio);
+        // each successful scale down step lowers the scale by .025, so rather 
+        // than fitting the row after every step, find the first step that 
+        // fits with a binary search (the row only gets shorter as the scale 
+        // goes down)
+        if (scale - .0125f >= minScale && tries > 0) {
+            float steps[128];
+            size_t stepCount = 0;
+            for (
+                auto next = scale;
+                next - .0125f >= minScale && stepCount < std::size(steps) &&
+                    static_cast<int>(stepCount) <= tries;
+            ) {
+                next = next - .0125f - .0125f;
+                steps[stepCount++] = next;
+            }
+            size_t lo = 0;
+            size_t hi = stepCount - 1;
+            while (lo < hi) {
+                auto mid = (lo + hi) / 2;
+                fit(count, steps[mid], squish, prio);
+                if (axisLength > available.axisLength) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+            scale = steps[lo];
+            tries -= static_cast<int>(lo + 1);
+        }
+        else if (this->canTryScalingDown(
+            rowBegin, rowEnd, prio, scale, scale - .0125f, minMaxPrios
         )) {
             scale -= .0125f;
+            tries -= 1;
         }
         else {
             squish = available.axisLength / (axisUnsquishedLength + .01f) * squish;
+            tries -= 1;
         }
-        fit(res);
+        fit(count, scale, squish, prio);
         // Avoid infinite loops
-        if (tries-- <= 0) {
+        if (tries < 0) {
             break;
         }
     }
 
-    // reverse row if needed
-    if (m_axisReverse) {
-        res->reverseObjects();
-    }
-
     float axisEndsLength = 0.f;
-    if (res->count()) {
-        auto first = static_cast<CCNode*>(res->firstObject());
-        auto last = static_cast<CCNode*>(res->lastObject());
+    if (count) {
+        auto first = &nodes[m_axisReverse ? end - 1 : begin];
+        auto last = &nodes[m_axisReverse ? begin : end - 1];
         axisEndsLength = (
-            first->getScaledContentSize().width * 
-                scaleByOpts(axisOpts(first), scale, prio, false) / 2 +
-            last->getScaledContentSize().width * 
-                scaleByOpts(axisOpts(last), scale, prio, false) / 2
+            first->scaledWidth * scaleByOpts(first->opts, scale, prio, false) / 2 +
+            last->scaledWidth * scaleByOpts(last->opts, scale, prio, false) / 2
         );
     }
 
-    return new Row(
+    return Row {
         // how much should the nodes be scaled down to fit the next row
         // the .01f is because floating point arithmetic is imprecise and you 
         // end up in a situation where it confidently tells you that
         // 241 > 241 == true
-        scaleDownFactor,
+        .nextOverflowScaleDownFactor = scaleDownFactor,
         // how much should the nodes be squished to fit the next item in this 
         // row
-        squishFactor,
-        axisLength, crossLength, axisEndsLength,
-        res,
-        scale, squish, prio
-    );
+        .nextOverflowSquishFactor = squishFactor,
+        .axisLength = axisLength,
+        .crossLength = crossLength,
+        .axisEndsLength = axisEndsLength,
+        .begin = begin,
+        .end = end,
+        .scale = scale,
+        .squish = squish,
+        .prio = static_cast<float>(prio),
+    };
 }
 
 bool AxisLayout::canTryScalingDown(
-    CCArray* nodes,
+    NodeInfo const* begin, NodeInfo const* end,
     int& prio, float& scale,
     float crossScaleDownFactor,
     std::pair<int, int> const& minMaxPrios
 ) const {
     bool attemptRescale = false;
-    auto minScaleForPrio = this->minScaleForPrio(nodes, prio);
+    auto minScaleForPrio = this->minScaleForPrio(begin, end, prio);
     if (
         // if the scale is less than the lowest min scale allowed, then 
         // trying to scale will have no effect and not help anywmore
@@ -452,7 +486,7 @@ bool AxisLayout::canTryScalingDown(
         if (prio > minMaxPrios.first) {
             while (true) {
                 prio -= 1;
-                auto mscale = this->maxScaleForPrio(nodes, prio);
+                auto mscale = this->maxScaleForPrio(begin, end, prio);
                 if (!mscale) {
                     continue;
                 }
@@ -474,115 +508,159 @@ bool AxisLayout::canTryScalingDown(
     return attemptRescale;
 }
 
-void AxisLayout::tryFitLayout(
-    CCNode* on, CCArray* nodes,
+bool AxisLayout::fitRows(
+    CCNode* on, std::vector<NodeInfo> const& nodes, std::vector<Row>& rows,
     std::pair<int, int> const& minMaxPrios,
     bool doAutoScale,
     float scale, float squish, int prio,
-    size_t depth
+    FitResult& res
 ) const {
-    // where do all of these magical calculations come from?
-    // idk i got tired of doing the math but they work so ¯\_(ツ)_/¯ 
-    // like i genuinely have no clue fr why some of these work tho, 
-    // i just threw in random equations and numbers until it worked
-
-    auto rows = CCArray::create();
-    float maxRowAxisLength = 0.f;
-    float totalRowCrossLength = 0.f;
-    float crossScaleDownFactor = 0.f;
-    float crossSquishFactor = 0.f;
+    rows.clear();
+    res = FitResult();
 
     // fit everything into rows while possible
     size_t ix = 0;
-    auto newNodes = nodes->shallowCopy();
-    while (newNodes->count()) {
+    size_t begin = 0;
+    while (begin < nodes.size()) {
         auto row = this->fitInRow(
-            on, newNodes,
+            on, nodes, begin,
             minMaxPrios, doAutoScale,
             scale, squish, prio
         );
-        rows->addObject(row);
         if (
-            row->nextOverflowScaleDownFactor > crossScaleDownFactor &&
-            row->nextOverflowScaleDownFactor < scale
+            row.nextOverflowScaleDownFactor > res.crossScaleDownFactor &&
+            row.nextOverflowScaleDownFactor < scale
         ) {
-            crossScaleDownFactor = row->nextOverflowScaleDownFactor;
+            res.crossScaleDownFactor = row.nextOverflowScaleDownFactor;
         }
         if (
-            row->nextOverflowSquishFactor > crossSquishFactor &&
-            row->nextOverflowSquishFactor < squish
+            row.nextOverflowSquishFactor > res.crossSquishFactor &&
+            row.nextOverflowSquishFactor < squish
         ) {
-            crossSquishFactor = row->nextOverflowSquishFactor;
+            res.crossSquishFactor = row.nextOverflowSquishFactor;
         }
-        totalRowCrossLength += row->crossLength;
+        res.totalRowCrossLength += row.crossLength;
         if (ix) {
-            totalRowCrossLength += m_gap;
+            res.totalRowCrossLength += m_gap;
         }
-        if (row->axisLength > maxRowAxisLength) {
-            maxRowAxisLength = row->axisLength;
+        if (row.axisLength > res.maxRowAxisLength) {
+            res.maxRowAxisLength = row.axisLength;
         }
+        begin = row.end;
+        rows.push_back(row);
         ix++;
     }
-    newNodes->release();
 
-    if (!rows->count()) {
-        return;
-    }
+    return rows.size();
+}
+
+void AxisLayout::tryFitLayout(
+    CCNode* on, std::vector<NodeInfo> const& nodes,
+    std::pair<int, int> const& minMaxPrios,
+    bool doAutoScale,
+    float scale, float squish, int prio
+) const {
+    // where do all of these magical calculations come from?
+    // idk i got tired of doing the math but they work so ¯\_(ツ)_/¯ 
+    // like i genuinely have no clue fr why some of these work tho, 
+    // i just threw in random equations and numbers until it worked
+
+    std::vector<Row> rows;
+    rows.reserve(nodes.size());
+    FitResult fit;
 
     auto available = nodeAxis(on, m_axis, 1.f / on->getScale());
-    if (available.axisLength <= 0.f) {
-        return;
-    }
 
-    // if cross axis overflow not allowed and it's overflowing, try to scale 
-    // down layout if there are any nodes with auto-scale enabled (or 
-    // auto-scale is enabled by default)
-    if (
-        !m_allowCrossAxisOverflow && 
-        doAutoScale && 
-        totalRowCrossLength > available.crossLength && 
-        depth < RECURSION_DEPTH_LIMIT
-    ) {
-        if (this->canTryScalingDown(
-            nodes, prio, scale, crossScaleDownFactor, minMaxPrios
-        )) {
-            rows->release();
-            return this->tryFitLayout(
-                on, nodes,
-                minMaxPrios, doAutoScale,
-                scale, squish, prio,
-                depth + 1
-            );
+    auto nodesBegin = nodes.data();
+    auto nodesEnd = nodes.data() + nodes.size();
+
+    for (size_t depth = 0;; depth++) {
+        if (!this->fitRows(on, nodes, rows, minMaxPrios, doAutoScale, scale, squish, prio, fit)) {
+            return;
+        }
+        if (available.axisLength <= 0.f) {
+            return;
         }
-    }
 
-    // if we're still overflowing, squeeze nodes closer together
-    if (
-        !m_allowCrossAxisOverflow &&
-        totalRowCrossLength > available.crossLength && 
-        depth < RECURSION_DEPTH_LIMIT
-    ) {
-        // if squishing rows would take less squishing that squishing columns, 
-        // then squish rows
+        // if cross axis overflow not allowed and it's overflowing, try to scale 
+        // down layout if there are any nodes with auto-scale enabled (or 
+        // auto-scale is enabled by default)
         if (
-            !m_growCrossAxis ||
-            totalRowCrossLength / available.crossLength < crossSquishFactor
+            !m_allowCrossAxisOverflow && 
+            doAutoScale && 
+            fit.totalRowCrossLength > available.crossLength && 
+            depth < RECURSION_DEPTH_LIMIT
         ) {
-            rows->release();
-            return this->tryFitLayout(
-                on, nodes,
-                minMaxPrios, doAutoScale,
-                scale, crossSquishFactor, prio,
-                depth + 1
-            );
+            // every row asks for the same scale down step, so as long as 
+            // that step stays above the minimum scale, binary search for the 
+            // first step where the layout stops overflowing instead of trying 
+            // them one by one
+            auto minScale = this->minScaleForPrio(nodesBegin, nodesEnd, prio);
+            if (
+                fit.crossScaleDownFactor >= minScale &&
+                fabsf(fit.crossScaleDownFactor - scale) >= .001f
+            ) {
+                float steps[128];
+                size_t stepCount = 0;
+                for (
+                    auto next = scale;
+                    next - .0125f >= minScale && next - .0125f > 0.f &&
+                        stepCount < std::size(steps) &&
+                        depth + stepCount < RECURSION_DEPTH_LIMIT;
+                ) {
+                    next -= .0125f;
+                    steps[stepCount++] = next;
+                }
+                if (stepCount) {
+                    size_t lo = 0;
+                    size_t hi = stepCount - 1;
+                    while (lo < hi) {
+                        auto mid = (lo + hi) / 2;
+                        this->fitRows(
+                            on, nodes, rows, minMaxPrios, doAutoScale, steps[mid], squish, prio, fit
+                        );
+                        if (fit.totalRowCrossLength > available.crossLength) {
+                            lo = mid + 1;
+                        }
+                        else {
+                            hi = mid;
+                        }
+                    }
+                    scale = steps[lo];
+                    depth += lo;
+                    continue;
+                }
+            }
+            if (this->canTryScalingDown(
+                nodesBegin, nodesEnd, prio, scale, fit.crossScaleDownFactor, minMaxPrios
+            )) {
+                continue;
+            }
+        }
+
+        // if we're still overflowing, squeeze nodes closer together
+        if (
+            !m_allowCrossAxisOverflow &&
+            fit.totalRowCrossLength > available.crossLength && 
+            depth < RECURSION_DEPTH_LIMIT
+        ) {
+            // if squishing rows would take less squishing that squishing columns, 
+            // then squish rows
+            if (
+                !m_growCrossAxis ||
+                fit.totalRowCrossLength / available.crossLength < fit.crossSquishFactor
+            ) {
+                squish = fit.crossSquishFactor;
+                continue;
+            }
         }
+
+        break;
     }
 
     // if we're here, the nodes are ready to be positioned
 
-    if (m_crossReverse) {
-        rows->reverseObjects();
-    }
+    auto totalRowCrossLength = fit.totalRowCrossLength;
 
     // resize cross axis if needed
     if (m_allowCrossAxisOverflow) {
@@ -607,12 +685,9 @@ void AxisLayout::tryFitLayout(
         totalRowCrossLength *= columnSquish;
     }
 
-    float rowsEndsLength = 0.f;
-    if (rows->count()) {
-        auto first = static_cast<Row*>(rows->firstObject());
-        auto last = static_cast<Row*>(rows->lastObject());
-        rowsEndsLength = first->crossLength / 2 + last->crossLength / 2;
-    }
+    auto& firstRow = m_crossReverse ? rows.back() : rows.front();
+    auto& lastRow = m_crossReverse ? rows.front() : rows.back();
+    float rowsEndsLength = firstRow.crossLength / 2 + lastRow.crossLength / 2;
 
     float rowCrossPos;
     switch (m_crossAlignment) {
@@ -636,16 +711,17 @@ void AxisLayout::tryFitLayout(
         } break;
     }
 
-    float rowEvenSpace = available.crossLength / rows->count();
+    float rowEvenSpace = available.crossLength / rows.size();
 
-    for (auto row : CCArrayExt<Row*>(rows)) {
-        row->accountSpacers(m_axis, available.axisLength);
+    for (size_t rowIx = 0; rowIx < rows.size(); rowIx++) {
+        auto& row = rows[m_crossReverse ? rows.size() - 1 - rowIx : rowIx];
+        row.accountSpacers(m_axis, available.axisLength, nodes.data());
 
         if (m_crossAlignment == AxisAlignment::Even) {
-            rowCrossPos -= rowEvenSpace / 2 + row->crossLength / 2;
+            rowCrossPos -= rowEvenSpace / 2 + row.crossLength / 2;
         }
         else {
-            rowCrossPos -= row->crossLength * columnSquish;
+            rowCrossPos -= row.crossLength * columnSquish;
         }
 
         float rowAxisPos;
@@ -659,23 +735,26 @@ void AxisLayout::tryFitLayout(
             } break;
 
             case AxisAlignment::Center: {
-                rowAxisPos = available.axisLength / 2 - row->axisLength / 2;
+                rowAxisPos = available.axisLength / 2 - row.axisLength / 2;
             } break;
 
             case AxisAlignment::End: {
-                rowAxisPos = available.axisLength - row->axisLength;
+                rowAxisPos = available.axisLength - row.axisLength;
             } break;
         }
 
-        float evenSpace = available.axisLength / row->nodes->count();
+        auto rowCount = row.end - row.begin;
+        float evenSpace = available.axisLength / rowCount;
 
-        size_t ix = 0;
         AxisLayoutOptions const* prev = nullptr;
-        for (auto& node : CCArrayExt<CCNode*>(row->nodes)) {
-            auto opts = axisOpts(node);
+        for (size_t ix = 0; ix < rowCount; ix++) {
+            auto const& info = nodes[m_axisReverse ? row.end - 1 - ix : row.begin + ix];
+            auto node = info.node;
+            auto opts = info.opts;
+            float nodeScale = 1.f;
             // rescale node if overflowing
-            if (this->shouldAutoScale(opts)) {
-                auto nodeScale = scaleByOpts(opts, row->scale, row->prio, false);
+            if (info.autoScale) {
+                nodeScale = scaleByOpts(opts, row.scale, row.prio, false);
                 // CCMenuItemSpriteExtra is quirky af
                 if (auto btn = typeinfo_cast<CCMenuItemSpriteExtra*>(node)) {
                     btn->m_baseScale = nodeScale;
@@ -683,27 +762,30 @@ void AxisLayout::tryFitLayout(
                 node->setScale(nodeScale);
             }
             if (!ix) {
-                rowAxisPos += row->axisEndsLength * row->scale / 2 * (1.f - row->squish);
+                rowAxisPos += row.axisEndsLength * row.scale / 2 * (1.f - row.squish);
             }
-            auto pos = nodeAxis(node, m_axis, row->squish);
+            auto pos = nodeAxis(
+                info.scalable ? info.size * nodeScale * row.squish : info.size,
+                info.anchor, info.length, m_axis
+            );
             float axisPos;
             if (m_axisAlignment == AxisAlignment::Even) {
                 axisPos = rowAxisPos + evenSpace / 2 - pos.axisLength * (.5f - pos.axisAnchor);
                 rowAxisPos += evenSpace - 
-                    row->axisEndsLength * row->scale * (1.f - row->squish) * 1.f / nodes->count();
+                    row.axisEndsLength * row.scale * (1.f - row.squish) * 1.f / nodes.size();
             }
             else {
                 if (ix) {
-                    if (row->prio == minMaxPrios.first) {
-                        rowAxisPos += this->nextGap(prev, opts) * row->scale * row->squish;
+                    if (row.prio == minMaxPrios.first) {
+                        rowAxisPos += this->nextGap(prev, opts) * row.scale * row.squish;
                     }
                     else {
-                        rowAxisPos += this->nextGap(prev, opts) * row->squish;
+                        rowAxisPos += this->nextGap(prev, opts) * row.squish;
                     }
                 }
                 axisPos = rowAxisPos + pos.axisLength * pos.axisAnchor;
                 rowAxisPos += pos.axisLength - 
-                    row->axisEndsLength * row->scale * (1.f - row->squish) * 1.f / nodes->count();
+                    row.axisEndsLength * row.scale * (1.f - row.squish) * 1.f / nodes.size();
             }
             float crossOffset;
             switch (m_crossLineAlignment) {
@@ -712,11 +794,11 @@ void AxisLayout::tryFitLayout(
                 } break;
 
                 case AxisAlignment::Center: case AxisAlignment::Even: {
-                    crossOffset = row->crossLength / 2 - pos.crossLength * (.5f - pos.crossAnchor);
+                    crossOffset = row.crossLength / 2 - pos.crossLength * (.5f - pos.crossAnchor);
                 } break;
 
                 case AxisAlignment::End: {
-                    crossOffset = row->crossLength - pos.crossLength * (1.f - pos.crossAnchor);
+                    crossOffset = row.crossLength - pos.crossLength * (1.f - pos.crossAnchor);
                 } break;
             }
             if (m_axis == Axis::Row) {
@@ -726,30 +808,107 @@ void AxisLayout::tryFitLayout(
                 node->setPosition(rowCrossPos + crossOffset, axisPos);
             }
             prev = opts;
-            ix++;
         }
     
         if (m_crossAlignment == AxisAlignment::Even) {
-            rowCrossPos -= rowEvenSpace / 2 - row->crossLength / 2 - 
-                rowsEndsLength * 1.5f * row->scale * (1.f - columnSquish) * 1.f / rows->count();
+            rowCrossPos -= rowEvenSpace / 2 - row.crossLength / 2 - 
+                rowsEndsLength * 1.5f * row.scale * (1.f - columnSquish) * 1.f / rows.size();
         }
         else {
             rowCrossPos -= m_gap * columnSquish - 
-                rowsEndsLength * 1.5f * row->scale * (1.f - columnSquish) * 1.f / rows->count();
+                rowsEndsLength * 1.5f * row.scale * (1.f - columnSquish) * 1.f / rows.size();
         }
     }
 }
 
+static void hashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <class T>
+static void hashValue(size_t& seed, T const& value) {
+    hashCombine(seed, std::hash<T>()(value));
+}
+
+static void hashSize(size_t& seed, CCSize const& size) {
+    hashValue(seed, size.width);
+    hashValue(seed, size.height);
+}
+
+static void hashPoint(size_t& seed, CCPoint const& point) {
+    hashValue(seed, point.x);
+    hashValue(seed, point.y);
+}
+
+size_t AxisLayout::layoutHash(CCNode* on) const {
+    size_t hash = 0;
+    hashValue(hash, static_cast<void*>(on));
+    hashSize(hash, on->getContentSize());
+    hashValue(hash, on->getScale());
+    hashValue(hash, static_cast<int>(m_axis));
+    hashValue(hash, static_cast<int>(m_axisAlignment));
+    hashValue(hash, static_cast<int>(m_crossAlignment));
+    hashValue(hash, static_cast<int>(m_crossLineAlignment));
+    hashValue(hash, m_gap);
+    hashValue(hash, m_autoScale);
+    hashValue(hash, m_axisReverse);
+    hashValue(hash, m_crossReverse);
+    hashValue(hash, m_allowCrossAxisOverflow);
+    hashValue(hash, m_growCrossAxis);
+    hashValue(hash, m_ignoreInvisibleChildren);
+    for (auto node : CCArrayExt<CCNode>(on->getChildren())) {
+        hashValue(hash, static_cast<void*>(node));
+        hashValue(hash, node->isVisible());
+        hashSize(hash, node->getContentSize());
+        hashValue(hash, node->getScaleX());
+        hashValue(hash, node->getScaleY());
+        hashPoint(hash, node->getPosition());
+        hashPoint(hash, node->getAnchorPoint());
+        if (auto toggle = typeinfo_cast<CCMenuItemToggler*>(node)) {
+            hashSize(hash, toggle->m_offButton->getScaledContentSize());
+        }
+        if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
+            hashValue(hash, spacer->getGrow());
+        }
+        if (auto opts = axisOpts(node)) {
+            hashValue(hash, static_cast<void const*>(opts));
+            hashValue(hash, opts->getAutoScale());
+            hashValue(hash, opts->getMaxScale());
+            hashValue(hash, opts->getMinScale());
+            hashValue(hash, opts->getRelativeScale());
+            hashValue(hash, opts->getLength());
+            hashValue(hash, opts->getPrevGap());
+            hashValue(hash, opts->getNextGap());
+            hashValue(hash, opts->getBreakLine());
+            hashValue(hash, opts->getSameLine());
+            hashValue(hash, opts->getScalePriority());
+        }
+    }
+    return hash;
+}
+
 void AxisLayout::apply(CCNode* on) {
-    auto nodes = getNodesToPosition(on);
+    // if nothing has changed since the layout was last applied, applying it 
+    // again would produce the exact same result
+    auto hash = this->layoutHash(on);
+    if (m_lastLayoutHash && hash == m_lastLayoutHash) {
+        return;
+    }
+
+    std::vector<NodeInfo> nodes;
+    nodes.reserve(on->getChildrenCount());
     
     std::pair<int, int> minMaxPrio;
     bool doAutoScale = false;
 
     bool first = true;
-    for (auto node : CCArrayExt<CCNode>(nodes)) {
+    for (auto node : CCArrayExt<CCNode>(on->getChildren())) {
+        if (m_ignoreInvisibleChildren && !node->isVisible()) {
+            continue;
+        }
+        auto opts = axisOpts(node);
         int prio = 0;
-        if (auto opts = axisOpts(node)) {
+        if (opts) {
             prio = opts->getScalePriority();
             // this does cause a recheck of m_autoScale every iteration but it 
             // should be pretty fast and this correctly handles the situation 
@@ -776,14 +935,43 @@ void AxisLayout::apply(CCNode* on) {
                 minMaxPrio.second = prio;
             }
         }
+
+        auto autoScale = this->shouldAutoScale(opts);
+        if (autoScale) {
+            node->setScale(1.f);
+        }
+        NodeInfo info {
+            .node = node,
+            .opts = opts,
+            .size = node->getScaledContentSize(),
+            .scalable = true,
+            .anchor = node->getAnchorPoint(),
+            .scaledWidth = node->getScaledContentSize().width,
+            .length = opts ? opts->getLength() : std::nullopt,
+            .autoScale = autoScale,
+        };
+        // CCMenuItemToggler is a common quirky class
+        if (auto toggle = typeinfo_cast<CCMenuItemToggler*>(node)) {
+            info.size = toggle->m_offButton->getScaledContentSize();
+            info.scalable = false;
+        }
+        if (typeinfo_cast<SpacerNode*>(node)) {
+            info.size = CCSizeZero;
+            info.scalable = false;
+        }
+        nodes.push_back(info);
+    }
+
+    if (nodes.size()) {
+        this->tryFitLayout(
+            on, nodes,
+            minMaxPrio, doAutoScale,
+            this->maxScaleForPrio(nodes.data(), nodes.data() + nodes.size(), minMaxPrio.second),
+            1.f, minMaxPrio.second
+        );
     }
 
-    this->tryFitLayout(
-        on, nodes,
-        minMaxPrio, doAutoScale,
-        this->maxScaleForPrio(nodes, minMaxPrio.second), 1.f, minMaxPrio.second,
-        0
-    );
+    m_lastLayoutHash = this->layoutHash(on);
 }
 
 CCSize AxisLayout::getSizeHint(CCNode* on) const {
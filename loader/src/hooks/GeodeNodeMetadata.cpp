@@ -1,8 +1,11 @@
 #include <Geode/modify/Field.hpp>
 #include <Geode/utils/cocos.hpp>
+#include <Geode/utils/InternedString.hpp>
+#include <Geode/loader/Loader.hpp>
 #include <Geode/modify/Field.hpp>
 #include <Geode/modify/CCNode.hpp>
 #include <cocos2d.h>
+#include <optional>
 
 using namespace geode::prelude;
 using namespace geode::modifier;
@@ -14,27 +17,71 @@ constexpr auto METADATA_TAG = 0xB324ABC;
 
 struct ProxyCCNode;
 
+struct IDIndexEntry {
+    // null if more than one node has the ID, in which case the children are 
+    // searched in order so the same node as always is found. The node isn't 
+    // retained, so an entry left behind by a change that didn't go through 
+    // the hooks is checked with GeodeNodeMetadata::isAlive before use
+    CCNode* node = nullptr;
+    size_t count = 0;
+};
+using IDIndex = std::unordered_map<InternedString, IDIndexEntry>;
+
 class GeodeNodeMetadata final : public cocos2d::CCObject {
 private:
     FieldContainer* m_fieldContainer;
     Ref<cocos2d::CCObject> m_userObject;
-    std::string m_id = "";
+    InternedString m_id;
     Ref<Layout> m_layout = nullptr;
     std::unique_ptr<LayoutOptions> m_layoutOptions = nullptr;
     std::unordered_map<std::string, json::Value> m_attributes;
     std::unordered_set<std::unique_ptr<EventListenerProtocol>> m_eventListeners;
     std::unordered_map<std::string, std::unique_ptr<EventListenerProtocol>> m_idEventListeners;
+    // ID -> node indices for getChildByID and getChildByIDRecursive. These 
+    // are only built for nodes that are slow to search, and are kept up to 
+    // date by the addChild, removeChild and setID hooks
+    std::optional<IDIndex> m_childIDIndex;
+    std::optional<IDIndex> m_subtreeIDIndex;
+    // how many children m_childIDIndex has seen, to notice children being 
+    // added or removed without going through the hooks
+    size_t m_childIDIndexCount = 0;
+    // whether an ancestor of this node has a subtree index, so adding a 
+    // child only walks up the tree for nodes inside an indexed subtree
+    bool m_hasIndexedAncestor = false;
+    // whether this node is in s_indexedNodes
+    bool m_indexed = false;
+    // the node this is the metadata of
+    CCNode* m_node;
+    // whether this node is waiting in s_pendingLayouts for its layout to be 
+    // updated before the next frame
+    bool m_layoutPending = false;
 
     friend class ProxyCCNode;
     friend class cocos2d::CCNode;
 
-    GeodeNodeMetadata() : m_fieldContainer(new FieldContainer()) {}
+    GeodeNodeMetadata(CCNode* node) : m_fieldContainer(new FieldContainer()), m_node(node) {}
 
     virtual ~GeodeNodeMetadata() {
         delete m_fieldContainer;
+        // the metadata is only owned by its node, so this runs when the node 
+        // is destroyed
+        if (m_indexed) {
+            s_indexedNodes.erase(m_node);
+        }
     }
 
 public:
+    // get the metadata of a node without creating it if it doesn't exist
+    static GeodeNodeMetadata* get(CCNode* target) {
+        if (!target) return nullptr;
+
+        auto old = target->m_pUserObject;
+        if (old && old->getTag() == METADATA_TAG) {
+            return static_cast<GeodeNodeMetadata*>(old);
+        }
+        return nullptr;
+    }
+
     static GeodeNodeMetadata* set(CCNode* target) {
         if (!target) return nullptr;
 
@@ -44,13 +91,13 @@ public:
         if (old && old->getTag() == METADATA_TAG) {
             return static_cast<GeodeNodeMetadata*>(old);
         }
-        auto meta = new GeodeNodeMetadata();
-        meta->autorelease();
+        // not autoreleased, so the metadata is destroyed together with the 
+        // node rather than at the end of the frame
+        auto meta = new GeodeNodeMetadata(target);
         meta->setTag(METADATA_TAG);
 
         // set user object
         target->m_pUserObject = meta;
-        meta->retain();
 
         if (old) {
             meta->m_userObject = old;
@@ -63,6 +110,334 @@ public:
     FieldContainer* getFieldContainer() {
         return m_fieldContainer;
     }
+
+    // Nodes whose layout has been requested through setLayoutOptions. Setting 
+    // the options of every child in a menu would otherwise update the menu's 
+    // layout once per child, so the requests are coalesced into one update 
+    // per node that runs before the next frame
+    static inline std::vector<Ref<CCNode>> s_pendingLayouts;
+
+    static void requestLayout(CCNode* node) {
+        auto meta = GeodeNodeMetadata::set(node);
+        if (meta->m_layoutPending) {
+            return;
+        }
+        meta->m_layoutPending = true;
+        if (s_pendingLayouts.empty()) {
+            Loader::get()->queueInGDThread([] {
+                auto pending = std::move(s_pendingLayouts);
+                s_pendingLayouts.clear();
+                for (auto& node : pending) {
+                    // the layout may have already been updated manually
+                    if (GeodeNodeMetadata::set(node)->m_layoutPending) {
+                        node->updateLayout();
+                    }
+                }
+            }, getMod());
+        }
+        s_pendingLayouts.push_back(node);
+    }
+
+    static InternedString getID(CCNode* node) {
+        if (auto meta = GeodeNodeMetadata::get(node)) {
+            return meta->m_id;
+        }
+        return InternedString();
+    }
+
+    static void setID(CCNode* node, InternedString id) {
+        auto meta = GeodeNodeMetadata::set(node);
+        auto parent = node->getParent();
+        auto update = [&](IDIndex& index) {
+            removeFromIndex(index, meta->m_id);
+            addToIndex(index, node, id);
+        };
+        if (auto parentMeta = GeodeNodeMetadata::get(parent); parentMeta && parentMeta->m_childIDIndex) {
+            update(*parentMeta->m_childIDIndex);
+        }
+        forEachSubtreeIndex(parent, update);
+        meta->m_id = id;
+    }
+
+    // call after child has been added to parent
+    static void childAdded(CCNode* parent, CCNode* child) {
+        auto id = GeodeNodeMetadata::getID(child);
+        if (auto meta = GeodeNodeMetadata::get(parent); meta && meta->m_childIDIndex) {
+            addToIndex(*meta->m_childIDIndex, child, id);
+            meta->m_childIDIndexCount += 1;
+        }
+        if (forEachSubtreeIndex(parent, [&](IDIndex& index) {
+            addToIndex(index, child, id);
+            addSubtreeToIndex(index, child);
+        })) {
+            markIndexedAncestor(child, true);
+        }
+    }
+
+    // call before child is removed from parent, as removing it may free it
+    static void childRemoved(CCNode* parent, CCNode* child) {
+        auto id = GeodeNodeMetadata::getID(child);
+        if (auto meta = GeodeNodeMetadata::get(parent); meta && meta->m_childIDIndex) {
+            removeFromIndex(*meta->m_childIDIndex, id);
+            meta->m_childIDIndexCount -= 1;
+        }
+        if (forEachSubtreeIndex(parent, [&](IDIndex& index) {
+            removeFromIndex(index, id);
+            removeSubtreeFromIndex(index, child);
+        })) {
+            markIndexedAncestor(child, false);
+        }
+    }
+
+    // call before all children are removed from parent
+    static void allChildrenRemoved(CCNode* parent) {
+        if (auto meta = GeodeNodeMetadata::get(parent); meta && meta->m_childIDIndex) {
+            meta->m_childIDIndex->clear();
+            meta->m_childIDIndexCount = 0;
+        }
+        if (forEachSubtreeIndex(parent, [&](IDIndex& index) {
+            removeSubtreeFromIndex(index, parent);
+        })) {
+            for (auto child : CCArrayExt<CCNode>(parent->getChildren())) {
+                markIndexedAncestor(child, false);
+            }
+        }
+    }
+
+private:
+    // lookups in nodes with less children than this just search them
+    static constexpr size_t MIN_INDEXED_CHILDREN = 16;
+    static constexpr size_t MIN_INDEXED_SUBTREE = 64;
+
+    // nodes that are or were the node of an index entry and haven't been 
+    // destroyed since, so entries can be checked without touching the node
+    static inline std::unordered_set<CCNode*> s_indexedNodes;
+
+    static void track(CCNode* node) {
+        auto meta = GeodeNodeMetadata::set(node);
+        if (!meta->m_indexed) {
+            meta->m_indexed = true;
+            s_indexedNodes.insert(node);
+        }
+    }
+
+    static bool isAlive(CCNode* node) {
+        return s_indexedNodes.contains(node);
+    }
+
+    // calls func with the subtree index of parent and every ancestor of it, 
+    // which are all the indices the children of parent are in. Returns 
+    // whether parent is in an indexed subtree at all
+    template <class F>
+    static bool forEachSubtreeIndex(CCNode* parent, F&& func) {
+        auto parentMeta = GeodeNodeMetadata::get(parent);
+        if (!parentMeta || !(parentMeta->m_subtreeIDIndex || parentMeta->m_hasIndexedAncestor)) {
+            return false;
+        }
+        for (auto node = parent; node; node = node->getParent()) {
+            auto meta = GeodeNodeMetadata::get(node);
+            if (meta && meta->m_subtreeIDIndex) {
+                func(*meta->m_subtreeIDIndex);
+            }
+        }
+        return true;
+    }
+
+    // set whether node and its descendants are in an indexed subtree; the 
+    // descendants of nodes with their own subtree index always are
+    static void markIndexedAncestor(CCNode* node, bool indexed) {
+        auto meta = indexed ? GeodeNodeMetadata::set(node) : GeodeNodeMetadata::get(node);
+        if (meta) {
+            meta->m_hasIndexedAncestor = indexed;
+            indexed = indexed || meta->m_subtreeIDIndex;
+        }
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            markIndexedAncestor(child, indexed);
+        }
+    }
+
+    static void addToIndex(IDIndex& index, CCNode* node, InternedString id) {
+        if (id.empty()) return;
+        auto& entry = index[id];
+        if (entry.count++) {
+            entry.node = nullptr;
+        }
+        else {
+            entry.node = node;
+            track(node);
+        }
+    }
+
+    static void removeFromIndex(IDIndex& index, InternedString id) {
+        if (id.empty()) return;
+        auto it = index.find(id);
+        if (it == index.end()) return;
+        if (--it->second.count == 0) {
+            index.erase(it);
+        }
+        else {
+            // which node is left isn't known, so the next lookup searches 
+            // for it
+            it->second.node = nullptr;
+        }
+    }
+
+    static void addSubtreeToIndex(IDIndex& index, CCNode* node) {
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            addToIndex(index, child, GeodeNodeMetadata::getID(child));
+            addSubtreeToIndex(index, child);
+        }
+    }
+
+    static void removeSubtreeFromIndex(IDIndex& index, CCNode* node) {
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            removeFromIndex(index, GeodeNodeMetadata::getID(child));
+            removeSubtreeFromIndex(index, child);
+        }
+    }
+
+    void buildChildIDIndex(CCNode* node) {
+        auto& index = m_childIDIndex.emplace();
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            addToIndex(index, child, GeodeNodeMetadata::getID(child));
+        }
+        m_childIDIndexCount = node->getChildrenCount();
+    }
+
+    void buildSubtreeIDIndex(CCNode* node) {
+        addSubtreeToIndex(m_subtreeIDIndex.emplace(), node);
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            markIndexedAncestor(child, true);
+        }
+    }
+
+    // the descendants keep m_hasIndexedAncestor, which only costs a walk up 
+    // the tree when children are added to them
+    void resetSubtreeIDIndex() {
+        m_subtreeIDIndex.reset();
+    }
+
+    static CCNode* searchChildren(CCNode* node, InternedString id) {
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            if (GeodeNodeMetadata::getID(child) == id) {
+                return child;
+            }
+        }
+        return nullptr;
+    }
+
+    static CCNode* searchSubtree(CCNode* node, InternedString id, size_t& searched) {
+        searched += node->getChildrenCount();
+        if (auto child = searchChildren(node, id)) {
+            return child;
+        }
+        for (auto child : CCArrayExt<CCNode>(node->getChildren())) {
+            if ((child = searchSubtree(child, id, searched))) {
+                return child;
+            }
+        }
+        return nullptr;
+    }
+
+    static CCNode* searchSubtree(CCNode* node, InternedString id) {
+        size_t searched = 0;
+        return searchSubtree(node, id, searched);
+    }
+
+    static bool isDescendant(CCNode* node, CCNode* ancestor) {
+        for (auto parent = node->getParent(); parent; parent = parent->getParent()) {
+            if (parent == ancestor) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    static CCNode* getChildByID(CCNode* node, InternedString id) {
+        auto meta = GeodeNodeMetadata::get(node);
+        auto indexed = meta && meta->m_childIDIndex;
+        // nodes without an ID aren't indexed
+        if (id.empty() || (!indexed && node->getChildrenCount() < MIN_INDEXED_CHILDREN)) {
+            return searchChildren(node, id);
+        }
+        meta = GeodeNodeMetadata::set(node);
+        // in case children were added or removed without going through the 
+        // hooked functions
+        if (indexed && meta->m_childIDIndexCount != node->getChildrenCount()) {
+            meta->m_childIDIndex.reset();
+        }
+        for (auto attempt = 0; attempt < 2; attempt++) {
+            if (!meta->m_childIDIndex) {
+                meta->buildChildIDIndex(node);
+            }
+            auto it = meta->m_childIDIndex->find(id);
+            if (it == meta->m_childIDIndex->end()) {
+                return nullptr;
+            }
+            auto& entry = it->second;
+            if (!entry.node) {
+                auto found = searchChildren(node, id);
+                if (found && entry.count == 1) {
+                    entry.node = found;
+                    track(found);
+                }
+                return found;
+            }
+            // the node may have been moved, renamed or even destroyed without 
+            // going through the hooks
+            if (
+                isAlive(entry.node) && entry.node->getParent() == node &&
+                GeodeNodeMetadata::getID(entry.node) == id
+            ) {
+                return entry.node;
+            }
+            meta->m_childIDIndex.reset();
+        }
+        return searchChildren(node, id);
+    }
+
+    static CCNode* getChildByIDRecursive(CCNode* node, InternedString id) {
+        if (id.empty()) {
+            return searchSubtree(node, id);
+        }
+        auto meta = GeodeNodeMetadata::get(node);
+        if (!meta || !meta->m_subtreeIDIndex) {
+            // only index the subtree once it's been slow to search
+            size_t searched = 0;
+            auto found = searchSubtree(node, id, searched);
+            if (searched >= MIN_INDEXED_SUBTREE) {
+                GeodeNodeMetadata::set(node)->buildSubtreeIDIndex(node);
+            }
+            return found;
+        }
+        for (auto attempt = 0; attempt < 2; attempt++) {
+            if (!meta->m_subtreeIDIndex) {
+                meta->buildSubtreeIDIndex(node);
+            }
+            auto it = meta->m_subtreeIDIndex->find(id);
+            if (it == meta->m_subtreeIDIndex->end()) {
+                return nullptr;
+            }
+            auto& entry = it->second;
+            if (!entry.node) {
+                auto found = searchSubtree(node, id);
+                if (found && entry.count == 1) {
+                    entry.node = found;
+                    track(found);
+                }
+                return found;
+            }
+            if (
+                isAlive(entry.node) && isDescendant(entry.node, node) &&
+                GeodeNodeMetadata::getID(entry.node) == id
+            ) {
+                return entry.node;
+            }
+            meta->resetSubtreeIDIndex();
+        }
+        return searchSubtree(node, id);
+    }
 };
 
 // proxy forwards
@@ -79,6 +454,24 @@ struct ProxyCCNode : Modify<ProxyCCNode, CCNode> {
     virtual void setUserObject(CCObject* obj) {
         GeodeNodeMetadata::set(this)->m_userObject = obj;
     }
+
+    // keep the ID indices of the parents up to date
+    virtual void addChild(CCNode* child, int zOrder, int tag) {
+        CCNode::addChild(child, zOrder, tag);
+        if (child && child->getParent() == this) {
+            GeodeNodeMetadata::childAdded(this, child);
+        }
+    }
+    virtual void removeChild(CCNode* child, bool cleanup) {
+        if (child && child->getParent() == this) {
+            GeodeNodeMetadata::childRemoved(this, child);
+        }
+        CCNode::removeChild(child, cleanup);
+    }
+    virtual void removeAllChildrenWithCleanup(bool cleanup) {
+        GeodeNodeMetadata::allChildrenRemoved(this);
+        CCNode::removeAllChildrenWithCleanup(cleanup);
+    }
 };
 
 static inline std::unordered_map<std::string, size_t> s_nextIndex;
@@ -90,36 +483,206 @@ size_t modifier::getFieldIndexForClass(size_t hash) {
 	return s_nextIndex[std::to_string(hash)]++;
 }
 
+namespace {
+    struct FieldInfo {
+        size_t classIndex;
+        // position among the fields of the same class
+        size_t position;
+        size_t size;
+        size_t align;
+        FieldConstructor constructor;
+        FieldDestructor destructor;
+    };
+
+    struct FieldClass {
+        // indices of the fields of this class in registration order
+        std::vector<size_t> fields;
+    };
+
+    struct FieldRegistry {
+        std::vector<FieldInfo> fields;
+        std::vector<FieldClass> classes;
+        std::unordered_map<std::string, size_t> classIndices;
+
+        static FieldRegistry& get() {
+            static FieldRegistry inst;
+            return inst;
+        }
+    };
+}
+
+size_t modifier::registerField(
+    char const* name, size_t size, size_t align,
+    FieldConstructor constructor, FieldDestructor destructor
+) {
+    auto& reg = FieldRegistry::get();
+    auto [it, inserted] = reg.classIndices.insert({ name, reg.classes.size() });
+    if (inserted) {
+        reg.classes.emplace_back();
+    }
+    auto& cls = reg.classes[it->second];
+    auto index = reg.fields.size();
+    reg.fields.push_back(FieldInfo {
+        .classIndex = it->second,
+        .position = cls.fields.size(),
+        .size = size,
+        .align = align,
+        .constructor = constructor,
+        .destructor = destructor,
+    });
+    cls.fields.push_back(index);
+    return index;
+}
+
+// A block holds the fields of one class in a single allocation: the header, 
+// then an offset and constructed flag for each field, then the fields 
+// themselves. Fields registered after a block was made for a node go into 
+// a new block for that node
+struct FieldContainer::Block {
+    struct Slot {
+        uint32_t offset;
+        bool constructed;
+    };
+
+    Block* next;
+    size_t classIndex;
+    // positions [first, first + count) of the class' fields
+    size_t first;
+    size_t count;
+    size_t align;
+
+    Slot* slots() {
+        return reinterpret_cast<Slot*>(this + 1);
+    }
+
+    std::byte* data() {
+        return reinterpret_cast<std::byte*>(this) + dataOffset(count, align);
+    }
+
+    static size_t alignUp(size_t value, size_t align) {
+        return (value + align - 1) / align * align;
+    }
+
+    static size_t dataOffset(size_t count, size_t align) {
+        return alignUp(sizeof(Block) + sizeof(Slot) * count, align);
+    }
+};
+
+FieldContainer::Block* FieldContainer::createBlock(size_t index) {
+    auto& reg = FieldRegistry::get();
+    auto const& info = reg.fields[index];
+    auto const& cls = reg.classes[info.classIndex];
+
+    // cover every field of the class that this node doesn't have a block for 
+    // yet, including any that have been registered since its last block
+    size_t first = 0;
+    for (auto block = m_blocks; block; block = block->next) {
+        if (block->classIndex == info.classIndex) {
+            first = std::max(first, block->first + block->count);
+        }
+    }
+    auto count = cls.fields.size() - first;
+
+    size_t align = alignof(std::max_align_t);
+    for (size_t i = first; i < cls.fields.size(); i++) {
+        align = std::max(align, reg.fields[cls.fields[i]].align);
+    }
+    size_t size = 0;
+    std::vector<uint32_t> offsets;
+    offsets.reserve(count);
+    for (size_t i = first; i < cls.fields.size(); i++) {
+        auto const& field = reg.fields[cls.fields[i]];
+        size = Block::alignUp(size, field.align);
+        offsets.push_back(static_cast<uint32_t>(size));
+        size += field.size;
+    }
+
+    auto memory = operator new(Block::dataOffset(count, align) + size, std::align_val_t(align));
+    auto block = new (memory) Block {
+        .next = m_blocks,
+        .classIndex = info.classIndex,
+        .first = first,
+        .count = count,
+        .align = align,
+    };
+    for (size_t i = 0; i < count; i++) {
+        new (&block->slots()[i]) Block::Slot { offsets[i], false };
+    }
+    m_blocks = block;
+    return block;
+}
+
+void* FieldContainer::getField(size_t index) {
+    auto const& info = FieldRegistry::get().fields[index];
+
+    auto block = m_blocks;
+    for (; block; block = block->next) {
+        if (
+            block->classIndex == info.classIndex &&
+            info.position >= block->first &&
+            info.position < block->first + block->count
+        ) {
+            break;
+        }
+    }
+    if (!block) {
+        block = this->createBlock(index);
+    }
+
+    auto& slot = block->slots()[info.position - block->first];
+    auto field = block->data() + slot.offset;
+    if (!slot.constructed) {
+        info.constructor(field);
+        slot.constructed = true;
+    }
+    return field;
+}
+
+FieldContainer::~FieldContainer() {
+    auto& reg = FieldRegistry::get();
+    while (auto block = m_blocks) {
+        auto const& cls = reg.classes[block->classIndex];
+        for (size_t i = block->count; i-- > 0;) {
+            auto& slot = block->slots()[i];
+            if (slot.constructed) {
+                reg.fields[cls.fields[block->first + i]].destructor(block->data() + slot.offset);
+            }
+        }
+        m_blocks = block->next;
+        auto align = block->align;
+        block->~Block();
+        operator delete(block, std::align_val_t(align));
+    }
+}
+
 // not const because might modify contents
 FieldContainer* CCNode::getFieldContainer() {
     return GeodeNodeMetadata::set(this)->getFieldContainer();
 }
 
 std::string CCNode::getID() {
-    return GeodeNodeMetadata::set(this)->m_id;
+    return GeodeNodeMetadata::getID(this).str();
+}
+
+std::string const& CCNode::getIDRef() {
+    return GeodeNodeMetadata::getID(this).str();
 }
 
 void CCNode::setID(std::string const& id) {
-    GeodeNodeMetadata::set(this)->m_id = id;
+    GeodeNodeMetadata::setID(this, id);
 }
 
 CCNode* CCNode::getChildByID(std::string const& id) {
-    for (auto child : CCArrayExt<CCNode>(m_pChildren)) {
-        if (child->getID() == id) {
-            return child;
-        }
+    // if the ID has never been interned, no node can have it
+    if (auto interned = InternedString::find(id)) {
+        return GeodeNodeMetadata::getChildByID(this, *interned);
     }
     return nullptr;
 }
 
 CCNode* CCNode::getChildByIDRecursive(std::string const& id) {
-    if (auto child = this->getChildByID(id)) {
-        return child;
-    }
-    for (auto child : CCArrayExt<CCNode>(m_pChildren)) {
-        if ((child = child->getChildByIDRecursive(id))) {
-            return child;
-        }
+    if (auto interned = InternedString::find(id)) {
+        return GeodeNodeMetadata::getChildByIDRecursive(this, *interned);
     }
     return nullptr;
 }
@@ -150,7 +713,7 @@ Layout* CCNode::getLayout() {
 void CCNode::setLayoutOptions(LayoutOptions* options, bool apply) {
     GeodeNodeMetadata::set(this)->m_layoutOptions.reset(options);
     if (apply && m_pParent) {
-        m_pParent->updateLayout();
+        GeodeNodeMetadata::requestLayout(m_pParent);
     }
 }
 
@@ -162,7 +725,9 @@ void CCNode::updateLayout(bool updateChildOrder) {
     if (updateChildOrder) {
         this->sortAllChildren();
     }
-    if (auto layout = GeodeNodeMetadata::set(this)->m_layout.data()) {
+    auto meta = GeodeNodeMetadata::set(this);
+    meta->m_layoutPending = false;
+    if (auto layout = meta->m_layout.data()) {
         layout->apply(this);
     }
 }
@@ -170,7 +735,7 @@ void CCNode::updateLayout(bool updateChildOrder) {
 AttributeSetEvent::AttributeSetEvent(CCNode* node, std::string const& id, json::Value& value)
   : node(node), id(id), value(value) {}
 
-ListenerResult AttributeSetFilter::handle(MiniFunction<Callback> fn, AttributeSetEvent* event) {
+ListenerResult AttributeSetFilter::handle(MiniFunctionRef<Callback> fn, AttributeSetEvent* event) {
     if (event->id == m_targetID) {
         fn(event);
     }
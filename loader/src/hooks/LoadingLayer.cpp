@@ -67,6 +67,9 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
             [&](UpdateFinished) {
                 this->setUpdateText("Resources Downloaded");
                 m_fields->m_updatingResources = false;
+                // the new files may have been looked up (and cached as 
+                // missing) while they were being downloaded
+                CCFileUtils::get()->updatePaths();
                 this->loadAssets();
             },
             [&](UpdateFailed const& error) {
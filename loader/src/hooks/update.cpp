@@ -1,4 +1,5 @@
 #include <loader/LoaderImpl.hpp>
+#include <loader/HookImpl.hpp>
 
 using namespace geode::prelude;
 
@@ -7,6 +8,9 @@ using namespace geode::prelude;
 struct FunctionQueue : Modify<FunctionQueue, CCScheduler> {
     void update(float dt) {
         LoaderImpl::get()->executeGDThreadQueue();
+        if (LoaderImpl::get()->isProfilingHooks()) {
+            Hook::Impl::sampleProfiles();
+        }
         return CCScheduler::update(dt);
     }
 };
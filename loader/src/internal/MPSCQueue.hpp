@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace geode {
+    /**
+     * Lock-free multi-producer single-consumer queue. Producers push onto an 
+     * intrusive stack with a single CAS, and the consumer takes the whole 
+     * stack at once with an exchange and reverses it to get the items back 
+     * in the order they were pushed
+     */
+    template <class T>
+    class MPSCQueue final {
+    protected:
+        struct Node {
+            std::optional<T> value;
+            Node* next = nullptr;
+        };
+
+        // Nodes are recycled through a free list shared by every queue of 
+        // this type. The consumer pushes drained nodes onto it, and producers 
+        // take the whole list at once into a thread-local cache, which avoids 
+        // the ABA problem of popping single nodes off a lock-free stack
+        struct NodeCache {
+            Node* head = nullptr;
+
+            ~NodeCache() {
+                while (head) {
+                    auto next = head->next;
+                    delete head;
+                    head = next;
+                }
+            }
+        };
+
+        static std::atomic<Node*>& freeNodes() {
+            static std::atomic<Node*> nodes = nullptr;
+            return nodes;
+        }
+
+        static Node* allocNode() {
+            thread_local NodeCache cache;
+            if (!cache.head) {
+                cache.head = freeNodes().exchange(nullptr, std::memory_order_acquire);
+            }
+            if (auto node = cache.head) {
+                cache.head = node->next;
+                return node;
+            }
+            return new Node();
+        }
+
+        // the nodes must already be linked from first to last
+        static void freeNodes(Node* first, Node* last) {
+            auto& nodes = freeNodes();
+            last->next = nodes.load(std::memory_order_relaxed);
+            while (!nodes.compare_exchange_weak(
+                last->next, first, std::memory_order_release, std::memory_order_relaxed
+            ));
+        }
+
+        std::atomic<Node*> m_head = nullptr;
+
+    public:
+        MPSCQueue() = default;
+        MPSCQueue(MPSCQueue const&) = delete;
+        MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+        ~MPSCQueue() {
+            this->drain([](T&&) {});
+        }
+
+        /**
+         * Push an item to the queue. Can be called from any thread
+         */
+        void push(T value) {
+            auto node = allocNode();
+            node->value.emplace(std::move(value));
+            node->next = m_head.load(std::memory_order_relaxed);
+            while (!m_head.compare_exchange_weak(
+                node->next, node, std::memory_order_release, std::memory_order_relaxed
+            ));
+        }
+
+        bool empty() const {
+            return m_head.load(std::memory_order_acquire) == nullptr;
+        }
+
+        /**
+         * Take every item currently in the queue and call func on each of 
+         * them in push order. Items pushed by func are left for the next 
+         * drain. Only call this from the consumer thread
+         */
+        template <class F>
+        void drain(F&& func) {
+            // fast path so an idle queue costs a single load
+            if (!m_head.load(std::memory_order_relaxed)) {
+                return;
+            }
+            auto node = m_head.exchange(nullptr, std::memory_order_acquire);
+            auto last = node;
+            Node* ordered = nullptr;
+            while (node) {
+                auto next = node->next;
+                node->next = ordered;
+                ordered = node;
+                node = next;
+            }
+            auto first = ordered;
+            while (ordered) {
+                func(std::move(*ordered->value));
+                ordered->value.reset();
+                ordered = ordered->next;
+            }
+            freeNodes(first, last);
+        }
+    };
+}
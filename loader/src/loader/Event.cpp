@@ -1,35 +1,66 @@
 #include <Geode/loader/Event.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <MPSCQueue.hpp>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
 
 using namespace geode::prelude;
 
 bool DefaultEventListenerPool::add(EventListenerProtocol* listener) {
-    if (m_locked) {
-        m_toAdd.push_back(listener);
+    if (m_indices.contains(listener)) {
+        return true;
     }
-    else {
-        // insert listeners at the start so new listeners get priority
-        m_listeners.insert(m_listeners.begin(), listener);
+    // listeners are appended and iterated back-to-front so new listeners get 
+    // priority
+    m_indices.insert({ listener, m_listeners.size() });
+    m_listeners.push_back(listener);
+    if (!m_locked) {
+        m_visible = m_listeners.size();
     }
     return true;
 }
 
 void DefaultEventListenerPool::remove(EventListenerProtocol* listener) {
-    for (size_t i = 0; i < m_listeners.size(); i++) {
-        if (m_listeners[i] == listener) {
-            m_listeners[i] = nullptr;
+    auto it = m_indices.find(listener);
+    if (it == m_indices.end()) {
+        return;
+    }
+    // leave a hole so indices of other listeners (and any iteration in 
+    // progress) stay valid
+    m_listeners[it->second] = nullptr;
+    m_indices.erase(it);
+    m_holes += 1;
+    if (!m_locked && m_holes > m_listeners.size() / 2) {
+        this->compact();
+    }
+}
+
+void DefaultEventListenerPool::compact() {
+    size_t count = 0;
+    for (auto listener : m_listeners) {
+        if (listener) {
+            m_indices[listener] = count;
+            m_listeners[count++] = listener;
         }
     }
-    ranges::remove(m_toAdd, listener);
+    m_listeners.resize(count);
+    m_visible = count;
+    m_holes = 0;
 }
 
 ListenerResult DefaultEventListenerPool::handle(Event* event) {
     auto res = ListenerResult::Propagate;
     m_locked += 1;
-    for (auto h : m_listeners) {
+    // iterate by index since listeners added by handlers may reallocate the 
+    // vector; those aren't visited as they are past m_visible
+    for (size_t i = m_visible; i-- > 0;) {
         // if an event listener gets destroyed in the middle of this loop, it 
         // gets set to null
+        auto h = m_listeners[i];
         if (h && h->handle(event) == ListenerResult::Stop) {
             res = ListenerResult::Stop;
             break;
@@ -39,11 +70,12 @@ ListenerResult DefaultEventListenerPool::handle(Event* event) {
     // only mutate listeners once nothing is iterating 
     // (if there are recursive handle calls)
     if (m_locked == 0) {
-        ranges::remove(m_listeners, nullptr);
-        for (auto listener : m_toAdd) {
-            m_listeners.insert(m_listeners.begin(), listener);
+        if (m_holes > m_listeners.size() / 2) {
+            this->compact();
+        }
+        else {
+            m_visible = m_listeners.size();
         }
-        m_toAdd.clear();
     }
     return res;
 }
@@ -53,6 +85,77 @@ DefaultEventListenerPool* DefaultEventListenerPool::get() {
     return inst;
 }
 
+namespace {
+    struct TypedPool {
+        DefaultEventListenerPool* pool;
+        bool(*matches)(Event*);
+    };
+
+    struct TypedPools {
+        std::mutex lock;
+        std::unordered_map<std::string, size_t> indices;
+        std::vector<TypedPool> pools;
+        // bumped whenever a pool is added so cached pool lists get rebuilt
+        std::atomic_size_t generation = 0;
+
+        static TypedPools& get() {
+            static auto inst = new TypedPools();
+            return *inst;
+        }
+    };
+
+    struct MatchingPools {
+        size_t generation;
+        std::shared_ptr<std::vector<DefaultEventListenerPool*> const> pools;
+    };
+}
+
+DefaultEventListenerPool* DefaultEventListenerPool::getForType(
+    char const* typeName, bool(*matches)(Event*)
+) {
+    auto& typed = TypedPools::get();
+    std::unique_lock _(typed.lock);
+    if (auto it = typed.indices.find(typeName); it != typed.indices.end()) {
+        return typed.pools[it->second].pool;
+    }
+    auto pool = new DefaultEventListenerPool();
+    typed.indices.insert({ typeName, typed.pools.size() });
+    typed.pools.push_back({ pool, matches });
+    typed.generation += 1;
+    return pool;
+}
+
+// Get the pools of every event type the event can be cast to. The lists are 
+// cached per thread and dynamic event type, so posting only locks when a new 
+// event type has been listened to since the last post of the same type
+static std::shared_ptr<std::vector<DefaultEventListenerPool*> const> getMatchingPools(Event* event) {
+    static thread_local std::unordered_map<std::type_info const*, MatchingPools> cache;
+
+    auto& typed = TypedPools::get();
+    auto& cached = cache[&typeid(*event)];
+    if (cached.pools && cached.generation == typed.generation) {
+        return cached.pools;
+    }
+
+    std::unique_lock _(typed.lock);
+    auto pools = std::make_shared<std::vector<DefaultEventListenerPool*>>();
+    // the pool for the event's own type goes first
+    if (auto it = typed.indices.find(typeid(*event).name()); it != typed.indices.end()) {
+        pools->push_back(typed.pools[it->second].pool);
+    }
+    for (auto& pool : typed.pools) {
+        if (pools->size() && pool.pool == pools->front()) {
+            continue;
+        }
+        if (pool.matches(event)) {
+            pools->push_back(pool.pool);
+        }
+    }
+    cached.generation = typed.generation;
+    cached.pools = std::move(pools);
+    return cached.pools;
+}
+
 EventListenerPool* EventListenerProtocol::getPool() const {
     return DefaultEventListenerPool::get();
 }
@@ -88,5 +191,76 @@ EventListenerPool* Event::getPool() const {
 
 ListenerResult Event::postFromMod(Mod* m) {
     if (m) this->sender = m;
-    return this->getPool()->handle(this);
+    auto pool = this->getPool();
+    if (pool != DefaultEventListenerPool::get()) {
+        return pool->handle(this);
+    }
+    // keep a reference to the list, as handlers may listen to new event 
+    // types which replaces the cached list
+    auto pools = getMatchingPools(this);
+    for (auto typed : *pools) {
+        if (typed->handle(this) == ListenerResult::Stop) {
+            return ListenerResult::Stop;
+        }
+    }
+    // listener protocols that don't pick a pool for their event type are in 
+    // the default pool
+    return pool->handle(this);
+}
+
+class EventQueue::Impl {
+public:
+    struct Queued {
+        std::unique_ptr<Event> event;
+        Mod* sender;
+        std::string coalesceKey;
+    };
+
+    MPSCQueue<Queued> m_queue;
+};
+
+EventQueue::EventQueue() : m_impl(std::make_unique<Impl>()) {}
+
+EventQueue::~EventQueue() {}
+
+EventQueue* EventQueue::get() {
+    static auto inst = new EventQueue();
+    return inst;
+}
+
+void EventQueue::push(std::unique_ptr<Event> event, Mod* sender, std::string const& coalesceKey) {
+    std::string key;
+    if (coalesceKey.size()) {
+        // events of different types may use the same keys
+        key = std::string(typeid(*event).name()) + ":" + coalesceKey;
+    }
+    m_impl->m_queue.push({ std::move(event), sender, std::move(key) });
+}
+
+void EventQueue::flush() {
+    if (m_impl->m_queue.empty()) {
+        return;
+    }
+    std::vector<Impl::Queued> batch;
+    m_impl->m_queue.drain([&](Impl::Queued&& queued) {
+        batch.push_back(std::move(queued));
+    });
+
+    // find the latest event for every coalesce key so earlier ones can be 
+    // skipped
+    std::unordered_map<std::string, size_t> latest;
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (batch[i].coalesceKey.size()) {
+            latest[batch[i].coalesceKey] = i;
+        }
+    }
+
+    // events queued by listeners are left for the next flush
+    for (size_t i = 0; i < batch.size(); i++) {
+        auto& queued = batch[i];
+        if (queued.coalesceKey.size() && latest.at(queued.coalesceKey) != i) {
+            continue;
+        }
+        (void)queued.event->postFromMod(queued.sender);
+    }
 }
@@ -3,6 +3,8 @@
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/casts.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include "ModImpl.hpp"
 #include "HookImpl.hpp"
@@ -70,6 +72,72 @@ void Hook::setAutoEnable(bool autoEnable) {
     return m_impl->setAutoEnable(autoEnable);
 }
 
+void Hook::setProfiledDetour(void* detour) {
+    return m_impl->setProfiledDetour(detour);
+}
+
+HookProfile const* Hook::getProfile() const {
+    return m_impl->getProfile();
+}
+
+// profiles are never freed, as the detour keeps a pointer to its profile 
+// around for as long as the program runs
+static std::mutex s_profilesMutex;
+static std::unordered_map<void*, std::unique_ptr<HookProfile>> s_profiles;
+
+HookProfile* Hook::getProfileFor(void* detour) {
+    std::lock_guard lock(s_profilesMutex);
+    auto& profile = s_profiles[detour];
+    if (!profile) {
+        profile = std::make_unique<HookProfile>();
+    }
+    return profile.get();
+}
+
+void Hook::Impl::sampleProfiles() {
+    static auto lastSample = std::chrono::steady_clock::now();
+    static uint64_t frames = 0;
+
+    frames += 1;
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastSample < std::chrono::seconds(1)) {
+        return;
+    }
+
+    std::lock_guard lock(s_profilesMutex);
+    for (auto& [detour, profile] : s_profiles) {
+        auto calls = profile->calls.load(std::memory_order_relaxed);
+        auto time = profile->exclusiveTime.load(std::memory_order_relaxed);
+        profile->recentCallsPerFrame = static_cast<double>(calls - profile->sampledCalls) / frames;
+        profile->recentTimePerFrame = static_cast<double>(time - profile->sampledExclusiveTime) / frames;
+        profile->sampledCalls = calls;
+        profile->sampledExclusiveTime = time;
+    }
+    lastSample = now;
+    frames = 0;
+}
+
+static thread_local HookProfileScope* s_currentProfileScope = nullptr;
+
+HookProfileScope::HookProfileScope(HookProfile* profile)
+  : m_profile(profile), m_parent(s_currentProfileScope),
+    m_start(std::chrono::steady_clock::now()) {
+    s_currentProfileScope = this;
+}
+
+HookProfileScope::~HookProfileScope() {
+    auto time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start
+    ).count());
+    m_profile->calls.fetch_add(1, std::memory_order_relaxed);
+    m_profile->inclusiveTime.fetch_add(time, std::memory_order_relaxed);
+    m_profile->exclusiveTime.fetch_add(time - m_nested, std::memory_order_relaxed);
+    if (m_parent) {
+        m_parent->m_nested += time;
+    }
+    s_currentProfileScope = m_parent;
+}
+
 Result<> Hook::enable() {
     return m_impl->enable();
 }
@@ -37,6 +37,11 @@ json::Value Hook::Impl::getRuntimeInfo() const {
     json["detour"] = std::to_string(reinterpret_cast<uintptr_t>(m_detour));
     json["name"] = m_displayName;
     json["enabled"] = m_enabled;
+    if (auto profile = this->getProfile()) {
+        json["calls"] = std::to_string(profile->calls.load(std::memory_order_relaxed));
+        json["inclusive-time"] = std::to_string(profile->inclusiveTime.load(std::memory_order_relaxed));
+        json["exclusive-time"] = std::to_string(profile->exclusiveTime.load(std::memory_order_relaxed));
+    }
     return json;
 }
 tulip::hook::HookMetadata Hook::Impl::getHookMetadata() const {
@@ -50,13 +55,63 @@ Result<> Hook::Impl::enable() {
         }
         GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getHandler(m_address));
 
-        m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
+        m_handle = tulip::hook::createHook(handler, this->getActiveDetour(), m_hookMetadata);
         log::debug("Enabling hook at function {} with address {}", m_displayName, m_address);
         m_enabled = true;
     }
     return Ok();
 }
 
+std::vector<std::pair<Hook*, std::string>> Hook::Impl::enableAll(std::span<Hook* const> hooks) {
+    std::vector<Hook*> pending;
+    pending.reserve(hooks.size());
+    for (auto hook : hooks) {
+        if (hook && !hook->m_impl->m_enabled) {
+            pending.push_back(hook);
+        }
+    }
+    // creating a handler is what patches the hooked function, so going 
+    // through the hooks in address order patches functions that share a page 
+    // back to back. the sort is stable so hooks on the same function are 
+    // still added in the order they were registered
+    std::stable_sort(pending.begin(), pending.end(), [](Hook* a, Hook* b) {
+        return a->m_impl->m_address < b->m_impl->m_address;
+    });
+
+    std::vector<std::pair<Hook*, std::string>> failed;
+    auto loader = LoaderImpl::get();
+
+    // create all the handlers first, then attach the hooks to them
+    std::unordered_map<void*, std::string> handlerErrors;
+    for (auto hook : pending) {
+        auto impl = hook->m_impl.get();
+        if (loader->hasHandler(impl->m_address) || handlerErrors.contains(impl->m_address)) {
+            continue;
+        }
+        auto res = loader->createHandler(impl->m_address, impl->m_handlerMetadata);
+        if (!res) {
+            handlerErrors.insert({ impl->m_address, res.unwrapErr() });
+        }
+    }
+    for (auto hook : pending) {
+        auto impl = hook->m_impl.get();
+        if (auto err = handlerErrors.find(impl->m_address); err != handlerErrors.end()) {
+            failed.push_back({ hook, err->second });
+            continue;
+        }
+        auto handler = loader->getHandler(impl->m_address);
+        if (!handler) {
+            failed.push_back({ hook, handler.unwrapErr() });
+            continue;
+        }
+        impl->m_handle = tulip::hook::createHook(
+            handler.unwrap(), impl->getActiveDetour(), impl->m_hookMetadata
+        );
+        impl->m_enabled = true;
+    }
+    return failed;
+}
+
 Result<> Hook::Impl::disable() {
     if (m_enabled) {
         GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getHandler(m_address));
@@ -101,4 +156,27 @@ bool Hook::Impl::getAutoEnable() const {
 
 void Hook::Impl::setAutoEnable(bool autoEnable) {
     m_autoEnable = autoEnable;
+}
+
+void Hook::Impl::setProfiledDetour(void* detour) {
+    m_profiledDetour = detour;
+    m_profile = detour ? Hook::getProfileFor(detour) : nullptr;
+}
+
+HookProfile const* Hook::Impl::getProfile() const {
+    // the profile only collects data if the hook was enabled with the 
+    // profiled detour
+    if (m_enabled && m_profile && this->getActiveDetour() == m_profiledDetour) {
+        return m_profile;
+    }
+    return nullptr;
+}
+
+void* Hook::Impl::getActiveDetour() const {
+    // the setting is only read on startup, so the detour doesn't change 
+    // between enabling and disabling a hook
+    if (m_profiledDetour && LoaderImpl::get()->isProfilingHooks()) {
+        return m_profiledDetour;
+    }
+    return m_detour;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/casts.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <span>
 #include <vector>
 #include "ModImpl.hpp"
 
@@ -30,10 +31,18 @@ public:
     tulip::hook::HookHandle m_handle;
     bool m_enabled = false;
     bool m_autoEnable = true;
+    // used instead of m_detour when hook profiling is enabled
+    void* m_profiledDetour = nullptr;
+    HookProfile* m_profile = nullptr;
+
+    void* getActiveDetour() const;
 
 
     // Used by Mod
     Result<> enable();
+    // Enable a batch of hooks at once. Returns the hooks that couldn't be 
+    // enabled along with the reason
+    static std::vector<std::pair<Hook*, std::string>> enableAll(std::span<Hook* const> hooks);
     Result<> disable();
     Result<> updateMetadata();
 
@@ -48,4 +57,10 @@ public:
     void setPriority(int32_t priority);
     bool getAutoEnable() const;
     void setAutoEnable(bool autoEnable);
+    void setProfiledDetour(void* detour);
+    HookProfile const* getProfile() const;
+
+    // Update the recent per frame averages of every hook profile. Called 
+    // once per frame while hooks are being profiled
+    static void sampleProfiles();
 };
\ No newline at end of file
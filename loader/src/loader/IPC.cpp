@@ -17,14 +17,17 @@ IPCEvent::IPCEvent(
     json::Value const& messageData,
     json::Value& replyData
 ) : m_rawPipeHandle(rawPipeHandle),
-    targetModID(targetModID),
-    messageID(messageID),
+    // the IDs come from other programs, so they're only looked up instead of 
+    // being added to the intern table for good. An ID that hasn't been 
+    // interned can't match any filter anyway
+    targetModID(InternedString::find(targetModID).value_or(InternedString())),
+    messageID(InternedString::find(messageID).value_or(InternedString())),
     replyData(replyData),
     messageData(std::make_unique<json::Value>(messageData)) {}
 
 IPCEvent::~IPCEvent() {}
 
-ListenerResult IPCFilter::handle(utils::MiniFunction<Callback> fn, IPCEvent* event) {
+ListenerResult IPCFilter::handle(utils::MiniFunctionRef<Callback> fn, IPCEvent* event) {
     if (event->targetModID == m_modID && event->messageID == m_messageID) {
         event->replyData = fn(event);
         return ListenerResult::Stop;
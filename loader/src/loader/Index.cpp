@@ -17,7 +17,7 @@ ModInstallEvent::ModInstallEvent(
     std::string const& id, const UpdateStatus status
 ) : modID(id), status(status) {}
 
-ListenerResult ModInstallFilter::handle(utils::MiniFunction<Callback> fn, ModInstallEvent* event) {
+ListenerResult ModInstallFilter::handle(utils::MiniFunctionRef<Callback> fn, ModInstallEvent* event) {
     if (m_id == event->modID) {
         fn(event);
     }
@@ -26,6 +26,18 @@ ListenerResult ModInstallFilter::handle(utils::MiniFunction<Callback> fn, ModIns
 
 ModInstallFilter::ModInstallFilter(std::string const& id) : m_id(id) {}
 
+// Install updates are posted asynchronously so download progress spam 
+// collapses into one event per frame. Every update for an install has to go 
+// through the queue so they stay in order
+static void postInstallUpdate(std::string const& id, UpdateStatus const& status) {
+    if (std::holds_alternative<UpdateProgress>(status)) {
+        postAsync(ModInstallEvent(id, status), id);
+    }
+    else {
+        postAsync(ModInstallEvent(id, status));
+    }
+}
+
 // IndexUpdateEvent implementation
 
 // The reason sources have private implementation events that are 
@@ -63,11 +75,21 @@ struct geode::SourceUpdateEvent : public Event {
       : source(src), status(status) {}
 };
 
+// Same as postInstallUpdate
+static void postSourceUpdate(IndexSourceImpl* src, UpdateStatus const& status) {
+    if (std::holds_alternative<UpdateProgress>(status)) {
+        postAsync(SourceUpdateEvent(src, status), src->repository);
+    }
+    else {
+        postAsync(SourceUpdateEvent(src, status));
+    }
+}
+
 class SourceUpdateFilter : public EventFilter<SourceUpdateEvent> {
 public:
     using Callback = void(SourceUpdateEvent*);
 
-    ListenerResult handle(utils::MiniFunction<Callback> fn, SourceUpdateEvent* event) {
+    ListenerResult handle(utils::MiniFunctionRef<Callback> fn, SourceUpdateEvent* event) {
         fn(event);
         return ListenerResult::Propagate;
     }
@@ -79,7 +101,7 @@ public:
 IndexUpdateEvent::IndexUpdateEvent(const UpdateStatus status) : status(status) {}
 
 ListenerResult IndexUpdateFilter::handle(
-    utils::MiniFunction<Callback> fn,
+    utils::MiniFunctionRef<Callback> fn,
     IndexUpdateEvent* event
 ) {
     fn(event);
@@ -262,7 +284,7 @@ void Index::checkSourceUpdates(IndexSourceImpl* src) {
     }
 
     log::debug("Checking updates for source {}", src->repository);
-    SourceUpdateEvent(src, UpdateProgress(0, "Checking status")).post();
+    postSourceUpdate(src, UpdateProgress(0, "Checking status"));
 
     // read old commit SHA
     // not using saved values for this one as we don't want to refetch 
@@ -293,17 +315,17 @@ void Index::checkSourceUpdates(IndexSourceImpl* src) {
             }
         })
         .expect([src](std::string const& err) {
-            SourceUpdateEvent(
+            postSourceUpdate(
                 src,
                 UpdateFailed(fmt::format("Error checking for updates: {}", err))
-            ).post();
+            );
         });
 }
 
 void Index::downloadSource(IndexSourceImpl* src) {
     log::debug("Downloading source {}", src->repository);
 
-    SourceUpdateEvent(src, UpdateProgress(0, "Beginning download")).post();
+    postSourceUpdate(src, UpdateProgress(0, "Beginning download"));
 
     auto targetFile = dirs::getIndexDir() / fmt::format("{}.zip", src->dirname());
 
@@ -320,9 +342,9 @@ void Index::downloadSource(IndexSourceImpl* src) {
                 }
             }
             catch(...) {
-                SourceUpdateEvent(
+                postSourceUpdate(
                     src, UpdateFailed("Unable to clear cached index")
-                ).post();
+                );
                 return;
             }
 
@@ -330,9 +352,9 @@ void Index::downloadSource(IndexSourceImpl* src) {
             auto unzip = file::Unzip::intoDir(targetFile, targetDir, true)
                 .expect("Unable to unzip new index");
             if (!unzip) {
-                SourceUpdateEvent(
+                postSourceUpdate(
                     src, UpdateFailed(unzip.unwrapErr())
-                ).post();
+                );
                 return;
             }
 
@@ -343,24 +365,24 @@ void Index::downloadSource(IndexSourceImpl* src) {
             this->updateSourceFromLocal(src);
         })
         .expect([src](std::string const& err) {
-            SourceUpdateEvent(
+            postSourceUpdate(
                 src, UpdateFailed(fmt::format("Error downloading: {}", err))
-            ).post();
+            );
         })
         .progress([src](auto&, double now, double total) {
-            SourceUpdateEvent(
+            postSourceUpdate(
                 src,
                 UpdateProgress(
                     static_cast<uint8_t>(now / total * 100.0),
                     "Downloading"
                 )
-            ).post();
+            );
         });
 }
 
 void Index::updateSourceFromLocal(IndexSourceImpl* src) {
     log::debug("Updating local cache for source {}", src->repository);
-    SourceUpdateEvent(src, UpdateProgress(100, "Updating local cache")).post();
+    postSourceUpdate(src, UpdateProgress(100, "Updating local cache"));
     // delete old items from this url if such exist
     for (auto& [_, versions] : m_items) {
         for (auto it = versions.begin(); it != versions.end(); ) {
@@ -397,15 +419,15 @@ void Index::updateSourceFromLocal(IndexSourceImpl* src) {
             });
         }
     } catch(std::exception& e) {
-        SourceUpdateEvent(src, fmt::format(
+        postSourceUpdate(src, fmt::format(
             "Unable to read source {}", src->repository
-        )).post();
+        ));
         return;
     }
 
     // mark source as finished
     src->isUpToDate = true;
-    SourceUpdateEvent(src, UpdateFinished()).post();
+    postSourceUpdate(src, UpdateFinished());
 }
 
 void Index::cleanupItems() {
@@ -455,7 +477,7 @@ void Index::update(bool force) {
                 this->checkSourceUpdates(src.get());
             }
         }
-    });
+    }, Mod::get());
 }
 
 // Items
@@ -621,7 +643,7 @@ Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
 void Index::installNext(size_t index, IndexInstallList const& list) {
     auto postError = [this, list](std::string const& error) {
         m_runningInstallations.erase(list.target);
-        ModInstallEvent(list.target->info.id(), error).post();
+        postInstallUpdate(list.target->info.id(), error);
     };
 
     // If we're at the end of the list, move the downloaded items to mods
@@ -657,7 +679,7 @@ void Index::installNext(size_t index, IndexInstallList const& list) {
         // load mods
         Loader::get()->refreshModsList();
 
-        ModInstallEvent(list.target->info.id(), UpdateFinished()).post();
+        postInstallUpdate(list.target->info.id(), UpdateFinished());
         return;
     }
 
@@ -669,31 +691,31 @@ void Index::installNext(size_t index, IndexInstallList const& list) {
 
     auto item = list.list.at(index);
     auto tempFile = dirs::getTempDir() / (item->info.id() + ".index");
+    // the file is hashed while it's being downloaded
+    auto sink = std::make_shared<HashingFileSink>(tempFile);
+    auto removeTempFile = [tempFile]() {
+        try {
+            ghc::filesystem::remove(tempFile);
+        }
+        catch(...) {}
+    };
     m_runningInstallations[list.target] = web::AsyncWebRequest()
         .join("install_item_" + item->info.id())
         .fetch(item->download.url)
-        .into(tempFile)
+        .into(*sink)
         .then([=](auto) {
-            // Check for 404
-            auto notFound = utils::file::readString(tempFile);
-            if (notFound && notFound.unwrap() == "Not Found") {
+            auto hash = sink->finish();
+            if (!*sink) {
+                removeTempFile();
                 return postError(fmt::format(
-                    "Binary file download for {} returned \"404 Not found\". "
-                    "Report this to the Geode development team.",
+                    "Unable to write downloaded file for {}",
                     item->info.id()
                 ));
             }
 
             // Verify checksum
-            ModInstallEvent(
-                list.target->info.id(),
-                UpdateProgress(
-                    scaledProgress(100),
-                    fmt::format("Verifying {}", item->info.id())
-                )
-            ).post();
-            
-            if (::calculateHash(tempFile) != item->download.hash) {
+            if (hash != item->download.hash) {
+                removeTempFile();
                 return postError(fmt::format(
                     "Checksum mismatch with {}! (Downloaded file did not match what "
                     "was expected. Try again, and if the download fails another time, "
@@ -705,22 +727,33 @@ void Index::installNext(size_t index, IndexInstallList const& list) {
             // Install next item in queue
             this->installNext(index + 1, list);
         })
-        .expect([postError, list, item](std::string const& err) {
+        .expect([postError, item, sink, removeTempFile](std::string const& err, int code) {
+            sink->finish();
+            removeTempFile();
+            if (code == 404) {
+                return postError(fmt::format(
+                    "Binary file download for {} returned \"404 Not found\". "
+                    "Report this to the Geode development team.",
+                    item->info.id()
+                ));
+            }
             postError(fmt::format(
                 "Unable to download {}: {}",
                 item->info.id(), err
             ));
         })
         .progress([this, item, list, scaledProgress](auto&, double now, double total) {
-            ModInstallEvent(
+            postInstallUpdate(
                 list.target->info.id(),
                 UpdateProgress(
                     scaledProgress(now / total * 100.0),
                     fmt::format("Downloading {}", item->info.id())
                 )
-            ).post();
+            );
         })
-        .cancelled([postError](auto&) {
+        .cancelled([postError, sink, removeTempFile](auto&) {
+            sink->finish();
+            removeTempFile();
             postError("Download cancelled");
         })
         .send();
@@ -732,13 +765,13 @@ void Index::cancelInstall(IndexItemHandle item) {
             m_runningInstallations.at(item)->cancel();
             m_runningInstallations.erase(item);
         }
-    });
+    }, Mod::get());
 }
 
 void Index::install(IndexInstallList const& list) {
     Loader::get()->queueInGDThread([this, list]() {
         this->installNext(0, list);
-    });
+    }, Mod::get());
 }
 
 void Index::install(IndexItemHandle item) {
@@ -750,12 +783,12 @@ void Index::install(IndexItemHandle item) {
         if (list) {
             this->install(list.unwrap());
         } else {
-            ModInstallEvent(
+            postInstallUpdate(
                 item->info.id(),
                 UpdateFailed(list.unwrapErr())
-            ).post();
+            );
         }
-    });
+    }, Mod::get());
 }
 
 // Item properites
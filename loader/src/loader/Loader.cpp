@@ -104,7 +104,11 @@ void Loader::updateResources(bool forceReload) {
 }
 
 void Loader::queueInGDThread(ScheduledFunction func) {
-    return m_impl->queueInGDThread(func);
+    return m_impl->queueInGDThread(func, nullptr);
+}
+
+void Loader::queueInGDThread(ScheduledFunction func, Mod* mod) {
+    return m_impl->queueInGDThread(func, mod);
 }
 
 void Loader::waitForModsToBeLoaded() {
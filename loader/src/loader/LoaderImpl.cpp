@@ -1,5 +1,6 @@
 
 #include "LoaderImpl.hpp"
+#include "HookImpl.hpp"
 #include <cocos2d.h>
 #include <Geode/loader/Dirs.hpp>
 #include <Geode/loader/IPC.hpp>
@@ -11,6 +12,7 @@
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <Geode/utils/string.hpp>
+#include <Geode/utils/timer.hpp>
 #include <Geode/utils/web.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include "ModImpl.hpp"
@@ -43,15 +45,14 @@ void Loader::Impl::createDirectories() {
     ghc::filesystem::create_directory(dirs::getSaveDir());
 #endif
 
-    // try deleting geode/unzipped if it already exists
-    try { ghc::filesystem::remove_all(dirs::getModRuntimeDir()); } catch(...) {}
-
     ghc::filesystem::create_directories(dirs::getGeodeResourcesDir());
     ghc::filesystem::create_directory(dirs::getModConfigDir());
     ghc::filesystem::create_directory(dirs::getModsDir());
     ghc::filesystem::create_directory(dirs::getGeodeLogDir());
     ghc::filesystem::create_directory(dirs::getTempDir());
     ghc::filesystem::create_directory(dirs::getModRuntimeDir());
+    // created here since mods create their save directories in parallel
+    ghc::filesystem::create_directories(dirs::getModsSaveDir());
 
     if (!ranges::contains(m_modSearchDirectories, dirs::getModsDir())) {
         m_modSearchDirectories.push_back(dirs::getModsDir());
@@ -92,7 +93,12 @@ Result<> Loader::Impl::setup() {
     if (!sett) {
         log::warn("Unable to load loader settings: {}", sett.unwrapErr());
     }
+    m_profileHooks = Mod::get()->getSettingValue<bool>("profile-hooks");
+    m_profileGDThreadQueue = Mod::get()->setting<bool>("profile-gd-thread-queue");
+    log::Logger::setBinarySink(Mod::get()->getSettingValue<bool>("binary-log"));
+    this->updateLogLevels();
     this->refreshModsList();
+    this->cleanupModRuntimeDir();
 
     this->queueInGDThread([]() {
         Loader::get()->addSearchPaths();
@@ -108,6 +114,52 @@ void Loader::Impl::addSearchPaths() {
     CCFileUtils::get()->addPriorityPath(dirs::getModRuntimeDir().string().c_str());
 }
 
+static std::optional<Severity> parseSeverity(std::string const& str) {
+    auto name = utils::string::toLower(utils::string::trim(str));
+    for (int i = Severity::Debug; i <= Severity::Emergency; i++) {
+        auto severity = Severity::cast(i);
+        if (utils::string::toLower(Severity::toString(severity)) == name) {
+            return severity;
+        }
+    }
+    return std::nullopt;
+}
+
+void Loader::Impl::updateLogLevels() {
+    auto level = Mod::get()->getSettingValue<std::string>("log-level");
+    if (auto severity = parseSeverity(level)) {
+        log::Logger::setMinSeverity(*severity);
+    }
+    else {
+        log::warn("Unknown log level \"{}\"", level);
+        log::Logger::setMinSeverity(Severity::Debug);
+    }
+
+    // drop the overrides that were removed from the setting since last time
+    for (auto& id : m_modLogLevels) {
+        log::Logger::setMinSeverity(id, std::nullopt);
+    }
+    m_modLogLevels.clear();
+
+    auto overrides = Mod::get()->getSettingValue<std::string>("mod-log-levels");
+    for (auto& entry : utils::string::split(overrides, ",")) {
+        if (utils::string::trim(entry).empty()) {
+            continue;
+        }
+        auto pos = entry.find('=');
+        auto severity = pos == std::string::npos ?
+            std::nullopt :
+            parseSeverity(entry.substr(pos + 1));
+        if (!severity) {
+            log::warn("Invalid mod log level \"{}\", expected \"mod.id=level\"", entry);
+            continue;
+        }
+        auto id = utils::string::trim(entry.substr(0, pos));
+        log::Logger::setMinSeverity(id, *severity);
+        m_modLogLevels.push_back(id);
+    }
+}
+
 void Loader::Impl::updateResources() {
     this->updateResources(true);
 }
@@ -194,11 +246,39 @@ Result<> Loader::Impl::loadData() {
 
 // Mod loading
 
-Result<Mod*> Loader::Impl::loadModFromInfo(ModInfo const& info) {
-    if (m_mods.count(info.id())) {
-        return Err(fmt::format("Mod with ID '{}' already loaded", info.id()));
+// Runs func for every index in [0, count) on a set of worker threads and 
+// waits for all of them to finish. What func logs is written afterwards from 
+// the calling thread, in index order
+template <class F>
+static void parallelFor(size_t count, F&& func) {
+    std::vector<std::vector<log::Log>> logs(count);
+    std::atomic_size_t next = 0;
+    auto work = [&]() {
+        for (size_t i; (i = next++) < count;) {
+            log::Logger::captureThread(&logs[i]);
+            func(i);
+            log::Logger::captureThread(nullptr);
+        }
+    };
+    auto threadCount = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u), count
+    );
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
     }
+    for (auto& list : logs) {
+        for (auto& log : list) {
+            log::Logger::push(std::move(log));
+        }
+    }
+}
 
+Result<Mod*> Loader::Impl::createMod(ModInfo const& info) {
     // create Mod instance
     auto mod = new Mod(info);
     auto setupRes = mod->m_impl->setup();
@@ -210,6 +290,28 @@ Result<Mod*> Loader::Impl::loadModFromInfo(ModInfo const& info) {
             info.id(), setupRes.unwrapErr()
         ));
     }
+    return Ok(mod);
+}
+
+Result<Mod*> Loader::Impl::loadModFromInfo(ModInfo const& info) {
+    if (m_mods.count(info.id())) {
+        return Err(fmt::format("Mod with ID '{}' already loaded", info.id()));
+    }
+    GEODE_UNWRAP_INTO(auto mod, this->createMod(info));
+    return this->addMod(mod);
+}
+
+Result<Mod*> Loader::Impl::addMod(Mod* mod) {
+    auto const& info = mod->m_impl->m_info;
+
+    // mods are added in dependency order, so the DataLoaded events are 
+    // queued here rather than when the data is read on a worker thread. The 
+    // mod is looked up again since it's deleted if it fails to load
+    this->queueInGDThread([id = info.id()]() {
+        if (auto mod = Loader::get()->getInstalledMod(id)) {
+            ModStateEvent(mod, ModEventType::DataLoaded).post();
+        }
+    });
 
     m_mods.insert({ info.id(), mod });
 
@@ -303,17 +405,31 @@ void Loader::Impl::updateModResources(Mod* mod) {
     }
 }
 
+void Loader::Impl::cleanupModRuntimeDir() {
+    // unzipped mods are kept between launches, so remove the directories of 
+    // mods that aren't installed anymore
+    std::error_code ec;
+    for (auto const& entry : ghc::filesystem::directory_iterator(dirs::getModRuntimeDir(), ec)) {
+        if (!m_mods.count(entry.path().filename().string())) {
+            log::debug("Removing unused unzipped directory {}", entry.path());
+            ghc::filesystem::remove_all(entry.path(), ec);
+        }
+    }
+}
+
 // Dependencies and refreshing
 
-void Loader::Impl::loadModsFromDirectory(
+void Loader::Impl::findModFiles(
     ghc::filesystem::path const& dir,
-    bool recursive
+    bool recursive,
+    std::unordered_set<std::string> const& loadedPaths,
+    std::vector<ghc::filesystem::path>& files
 ) {
     log::debug("Searching {}", dir);
     for (auto const& entry : ghc::filesystem::directory_iterator(dir)) {
         // recursively search directories
         if (ghc::filesystem::is_directory(entry) && recursive) {
-            this->loadModsFromDirectory(entry.path(), true);
+            this->findModFiles(entry.path(), true, loadedPaths, files);
             continue;
         }
 
@@ -327,35 +443,60 @@ void Loader::Impl::loadModsFromDirectory(
             continue;
         }
         // skip this entry if it's already loaded
-        if (map::contains<std::string, Mod*>(m_mods, [entry](Mod* p) -> bool {
-            return p->m_impl->m_info.path() == entry.path();
-        })) {
+        if (loadedPaths.contains(entry.path().string())) {
+            continue;
+        }
+
+        files.push_back(entry.path());
+    }
+}
+
+void Loader::Impl::loadModFiles(std::vector<ghc::filesystem::path> const& files) {
+    // opening the zips and parsing mod.json is independent for every file, 
+    // so do that on a bunch of threads first
+    std::vector<std::optional<Result<ModInfo>>> infos(files.size());
+    parallelFor(files.size(), [&](size_t i) {
+        try {
+            infos[i].emplace(ModInfo::createFromGeodeFile(files[i]));
+        }
+        catch(std::exception& e) {
+            infos[i].emplace(Err(std::string(e.what())));
+        }
+    });
+
+    // then handle the results in the order the files were found in so the 
+    // outcome doesn't depend on thread timing
+    std::unordered_set<std::string> toLoad;
+    for (auto& info : m_modsToLoad) {
+        toLoad.insert(info.id());
+    }
+    for (size_t i = 0; i < files.size(); i++) {
+        auto& res = infos[i].value();
+        if (!res) {
+            if (m_earlyLoadFinished) {
+                log::error("Unable to load {}: {}", files[i], res.unwrapErr());
+            }
+            m_invalidMods.push_back(InvalidGeodeFile {
+                .path = files[i],
+                .reason = res.unwrapErr(),
+            });
             continue;
         }
+        auto info = res.unwrap();
 
         // if mods should be loaded immediately, do that
         if (m_earlyLoadFinished) {
-            auto load = this->loadModFromFile(entry);
+            auto load = this->loadModFromInfo(info);
             if (!load) {
-                log::error("Unable to load {}: {}", entry, load.unwrapErr());
+                log::error("Unable to load {}: {}", files[i], load.unwrapErr());
             }
         }
         // otherwise collect mods to load first to make sure the correct 
         // versions of the mods are loaded and that early-loaded mods are 
         // loaded early
         else {
-            auto res = ModInfo::createFromGeodeFile(entry.path());
-            if (!res) {
-                m_invalidMods.push_back(InvalidGeodeFile {
-                    .path = entry.path(),
-                    .reason = res.unwrapErr(),
-                });
-                continue;
-            }
-            auto info = res.unwrap();
-
             // skip this entry if it's already set to be loaded
-            if (ranges::contains(m_modsToLoad, info)) {
+            if (!toLoad.insert(info.id()).second) {
                 continue;
             }
 
@@ -365,48 +506,173 @@ void Loader::Impl::loadModsFromDirectory(
     }
 }
 
-void Loader::Impl::refreshModsList() {
-    log::debug("Loading mods...");
+std::unordered_set<std::string> Loader::Impl::getLoadedModPaths() const {
+    std::unordered_set<std::string> paths;
+    for (auto& [_, mod] : m_mods) {
+        paths.insert(mod->m_impl->m_info.path().string());
+    }
+    return paths;
+}
 
-    // find mods
-    for (auto& dir : m_modSearchDirectories) {
-        this->loadModsFromDirectory(dir);
+void Loader::Impl::loadModsFromDirectory(
+    ghc::filesystem::path const& dir,
+    bool recursive
+) {
+    std::vector<ghc::filesystem::path> files;
+    this->findModFiles(dir, recursive, this->getLoadedModPaths(), files);
+    this->loadModFiles(files);
+}
+
+std::vector<ModInfo> Loader::Impl::sortModsToLoad() {
+    std::unordered_map<std::string, size_t> indices;
+    for (size_t i = 0; i < m_modsToLoad.size(); i++) {
+        indices.insert({ m_modsToLoad[i].id(), i });
+    }
+
+    // depth-first search through required dependencies; the post-order 
+    // puts every mod after its dependencies, and running into a mod that's 
+    // still being visited means there's a cycle
+    enum class State { Unvisited, Visiting, Visited };
+    std::vector<State> states(m_modsToLoad.size(), State::Unvisited);
+    std::unordered_map<size_t, std::string> cycles;
+    std::vector<size_t> stack;
+    std::vector<size_t> order;
+    auto visit = [&](auto& self, size_t index) -> void {
+        states[index] = State::Visiting;
+        stack.push_back(index);
+        for (auto const& dep : m_modsToLoad[index].dependencies()) {
+            if (!dep.required) {
+                continue;
+            }
+            // dependencies that aren't in the list are either loaded already 
+            // or missing, neither of which affect the order
+            auto it = indices.find(dep.id);
+            if (it == indices.end()) {
+                continue;
+            }
+            auto depIndex = it->second;
+            if (states[depIndex] == State::Visiting) {
+                auto begin = std::find(stack.begin(), stack.end(), depIndex);
+                std::string path;
+                for (auto i = begin; i != stack.end(); i++) {
+                    path += m_modsToLoad[*i].id() + " -> ";
+                }
+                path += dep.id;
+                for (auto i = begin; i != stack.end(); i++) {
+                    cycles.insert({ *i, path });
+                }
+            }
+            else if (states[depIndex] == State::Unvisited) {
+                self(self, depIndex);
+            }
+        }
+        stack.pop_back();
+        states[index] = State::Visited;
+        order.push_back(index);
+    };
+    for (size_t i = 0; i < m_modsToLoad.size(); i++) {
+        if (states[i] == State::Unvisited) {
+            visit(visit, i);
+        }
     }
-    
-    // load early-load mods first
-    for (auto& mod : m_modsToLoad) {
-        if (mod.needsEarlyLoad()) {
-            auto load = this->loadModFromInfo(mod);
-            if (!load) {
-                log::error("Unable to load {}: {}", mod.id(), load.unwrapErr());
 
+    // early-load mods still go first, but both groups are in dependency order
+    std::vector<ModInfo> sorted;
+    for (auto early : { true, false }) {
+        for (auto index : order) {
+            auto& info = m_modsToLoad[index];
+            if (info.needsEarlyLoad() != early) {
+                continue;
+            }
+            if (cycles.count(index)) {
+                log::error("Unable to load {}: dependency cycle {}", info.id(), cycles.at(index));
                 m_invalidMods.push_back(InvalidGeodeFile {
-                    .path = mod.path(),
-                    .reason = load.unwrapErr(),
+                    .path = info.path(),
+                    .reason = "Dependency cycle: " + cycles.at(index),
                 });
+                continue;
             }
+            sorted.push_back(info);
         }
     }
+    return sorted;
+}
 
-    // UI can be loaded now
-    m_earlyLoadFinished = true;
-    m_earlyLoadFinishedCV.notify_all();
+void Loader::Impl::loadModGroup(std::vector<ModInfo> const& infos) {
+    std::vector<std::optional<Result<Mod*>>> mods(infos.size());
+    std::vector<bool> enabled(infos.size());
+    for (size_t i = 0; i < infos.size(); i++) {
+        if (m_mods.count(infos[i].id())) {
+            mods[i].emplace(Err(fmt::format("Mod with ID '{}' already loaded", infos[i].id())));
+        }
+        // read beforehand since getSavedValue may write the default value
+        enabled[i] = Mod::get()->getSavedValue<bool>("should-load-" + infos[i].id(), true);
+    }
 
-    // load the rest of the mods
-    for (auto& mod : m_modsToLoad) {
-        if (!mod.needsEarlyLoad()) {
-            auto load = this->loadModFromInfo(mod);
-            if (!load) {
-                log::error("Unable to load {}: {}", mod.id(), load.unwrapErr());
+    // loading settings and saved data and unzipping don't depend on any 
+    // other mod, so do those for every mod at once
+    parallelFor(infos.size(), [&](size_t i) {
+        if (mods[i]) {
+            return;
+        }
+        auto res = this->createMod(infos[i]);
+        if (res && enabled[i]) {
+            // errors are reported when the binary is loaded
+            (void)ModImpl::getImpl(res.unwrap())->createTempDir();
+        }
+        mods[i].emplace(std::move(res));
+    });
 
-                m_invalidMods.push_back(InvalidGeodeFile {
-                    .path = mod.path(),
-                    .reason = load.unwrapErr(),
-                });
-            }
+    // hooking and loading binaries has to be done one mod at a time, and the 
+    // mods are sorted so dependencies are loaded first
+    for (size_t i = 0; i < infos.size(); i++) {
+        auto load = mods[i].value();
+        if (load) {
+            load = this->addMod(load.unwrap());
+        }
+        if (!load) {
+            log::error("Unable to load {}: {}", infos[i].id(), load.unwrapErr());
+
+            m_invalidMods.push_back(InvalidGeodeFile {
+                .path = infos[i].path(),
+                .reason = load.unwrapErr(),
+            });
         }
     }
+}
+
+void Loader::Impl::refreshModsList() {
+    log::debug("Loading mods...");
+    utils::Timer<std::chrono::steady_clock> timer;
+
+    // find mods
+    std::vector<ghc::filesystem::path> files;
+    auto loadedPaths = this->getLoadedModPaths();
+    for (auto& dir : m_modSearchDirectories) {
+        this->findModFiles(dir, true, loadedPaths, files);
+    }
+    this->loadModFiles(files);
+    log::info("Found {} mods in {}", m_modsToLoad.size(), timer.elapsedAsString());
+    timer.reset();
+
+    auto sorted = this->sortModsToLoad();
     m_modsToLoad.clear();
+    auto firstLate = std::find_if(sorted.begin(), sorted.end(), [](ModInfo const& info) {
+        return !info.needsEarlyLoad();
+    });
+
+    // load early-load mods first
+    this->loadModGroup(std::vector<ModInfo>(sorted.begin(), firstLate));
+    log::info("Loaded early-load mods in {}", timer.elapsedAsString());
+    timer.reset();
+
+    // UI can be loaded now
+    m_earlyLoadFinished = true;
+    m_earlyLoadFinishedCV.notify_all();
+
+    // load the rest of the mods
+    this->loadModGroup(std::vector<ModInfo>(firstLate, sorted.end()));
+    log::info("Loaded the rest of the mods in {}", timer.elapsedAsString());
 }
 
 void Loader::Impl::updateAllDependencies() {
@@ -428,6 +694,7 @@ bool Loader::Impl::didLastLaunchCrash() const {
 }
 
 void Loader::Impl::reset() {
+    log::Logger::flush();
     this->closePlatformConsole();
 
     for (auto& [_, mod] : m_mods) {
@@ -443,45 +710,106 @@ bool Loader::Impl::isReadyToHook() const {
     return m_readyToHook;
 }
 
+bool Loader::Impl::isProfilingHooks() const {
+    return m_profileHooks;
+}
+
 void Loader::Impl::addInternalHook(Hook* hook, Mod* mod) {
     m_internalHooks.push_back({hook, mod});
 }
 
 bool Loader::Impl::loadHooks() {
     m_readyToHook = true;
-    auto thereWereErrors = false;
+    utils::Timer<std::chrono::steady_clock> timer;
+    // the hooks were already added to their mods by Mod::addHook, they just 
+    // need to be enabled, which is done all at once
+    std::vector<Hook*> hooks;
+    hooks.reserve(m_internalHooks.size());
     for (auto const& hook : m_internalHooks) {
-        auto res = hook.second->addHook(hook.first);
-        if (!res) {
-            log::internalLog(Severity::Error, hook.second, "{}", res.unwrapErr());
-            thereWereErrors = true;
+        if (hook.first->getAutoEnable()) {
+            hooks.push_back(hook.first);
         }
     }
+    auto failed = Hook::Impl::enableAll(hooks);
+    for (auto const& [hook, err] : failed) {
+        log::internalLog(
+            Severity::Error, hook->getOwner(), "Can't create hook {}: {}", hook->getDisplayName(), err
+        );
+    }
+    log::debug(
+        "Enabled {} hooks in {}",
+        hooks.size() - failed.size(), timer.elapsedAsString<std::chrono::microseconds>()
+    );
     // free up memory
     m_internalHooks.clear();
-    return !thereWereErrors;
+    return failed.empty();
 }
 
-void Loader::Impl::queueInGDThread(ScheduledFunction func) {
-    std::lock_guard<std::mutex> lock(m_gdThreadMutex);
-    m_gdThreadQueue.push_back(func);
+void Loader::Impl::queueInGDThread(ScheduledFunction func, Mod* mod) {
+    m_gdThreadQueue.push(QueuedFunction { std::move(func), mod });
 }
 
 void Loader::Impl::executeGDThreadQueue() {
-    // copy queue to avoid locking mutex if someone is
-    // running addToGDThread inside their function
-    m_gdThreadMutex.lock();
-    auto queue = m_gdThreadQueue;
-    m_gdThreadQueue.clear();
-    m_gdThreadMutex.unlock();
-
-    // call queue
-    for (auto const& func : queue) {
-        func();
+    // functions queued while running the queue are run on the next frame
+    if (!m_gdThreadQueue.empty()) {
+        if (m_profileGDThreadQueue.get()) {
+            struct ModTime {
+                Mod* mod;
+                size_t count = 0;
+                int64_t time = 0;
+                int64_t slowest = 0;
+            };
+            // few mods queue functions on the same frame, so a vector is 
+            // enough
+            std::vector<ModTime> mods;
+            size_t count = 0;
+            utils::Timer<std::chrono::steady_clock> total;
+            m_gdThreadQueue.drain([&](QueuedFunction&& queued) {
+                utils::Timer<std::chrono::steady_clock> timer;
+                queued.func();
+                auto elapsed = timer.elapsed<std::chrono::microseconds>();
+                auto it = std::find_if(mods.begin(), mods.end(), [&](ModTime const& time) {
+                    return time.mod == queued.mod;
+                });
+                if (it == mods.end()) {
+                    it = mods.insert(mods.end(), ModTime { .mod = queued.mod });
+                }
+                it->count += 1;
+                it->time += elapsed;
+                it->slowest = std::max(it->slowest, elapsed);
+                count += 1;
+            });
+            auto elapsed = total.elapsed<std::chrono::microseconds>();
+            if (elapsed >= 1000) {
+                std::sort(mods.begin(), mods.end(), [](ModTime const& a, ModTime const& b) {
+                    return a.time > b.time;
+                });
+                std::string breakdown;
+                for (auto& time : mods) {
+                    breakdown += fmt::format(
+                        "\n  {}: {} functions in {}us (slowest took {}us)",
+                        time.mod ? time.mod->getID() : "unknown",
+                        time.count, time.time, time.slowest
+                    );
+                }
+                log::debug(
+                    "Ran {} queued functions in {}us this frame:{}", count, elapsed, breakdown
+                );
+            }
+        }
+        else {
+            m_gdThreadQueue.drain([](QueuedFunction&& queued) {
+                queued.func();
+            });
+        }
     }
+
+    // post events queued with postAsync
+    EventQueue::get()->flush();
 }
 
 void Loader::Impl::logConsoleMessage(std::string const& msg) {
+    std::lock_guard lock(m_platformConsoleMutex);
     if (m_platformConsoleOpen) {
         // TODO: make flushing optional
         std::cout << msg << '\n' << std::flush;
@@ -517,13 +845,22 @@ void Loader::Impl::tryDownloadLoaderResources(
 ) {
     auto tempResourcesZip = dirs::getTempDir() / "new.zip";
     auto resourcesDir = dirs::getGeodeResourcesDir() / Mod::get()->getID();
+    auto sink = std::make_shared<HashingFileSink>(tempResourcesZip);
 
     web::AsyncWebRequest()
         // use the url as a join handle
         .join(url)
         .fetch(url)
-        .into(tempResourcesZip)
-        .then([tempResourcesZip, resourcesDir, this](auto) {
+        .into(*sink)
+        .then([tempResourcesZip, resourcesDir, sink, this](auto) {
+            log::debug("Downloaded resources (SHA3-256 {})", sink->finish());
+            if (!*sink) {
+                ResourceDownloadEvent(
+                    UpdateFailed("Unable to write downloaded resources")
+                ).post();
+                return;
+            }
+
             // unzip resources zip
             auto unzip = file::Unzip::intoDir(tempResourcesZip, resourcesDir, true);
             if (!unzip) {
@@ -536,7 +873,8 @@ void Loader::Impl::tryDownloadLoaderResources(
 
             ResourceDownloadEvent(UpdateFinished()).post();
         })
-        .expect([this, tryLatestOnError](std::string const& info, int code) {
+        .expect([this, tryLatestOnError, sink](std::string const& info, int code) {
+            sink->finish();
             // if the url was not found, try downloading latest release instead
             // (for development versions)
             if (code == 404 && tryLatestOnError) {
@@ -667,12 +1005,21 @@ bool Loader::Impl::verifyLoaderResources() {
 void Loader::Impl::downloadLoaderUpdate(std::string const& url) {
     auto updateZip = dirs::getTempDir() / "loader-update.zip";
     auto targetDir = dirs::getGeodeDir() / "update";
+    auto sink = std::make_shared<HashingFileSink>(updateZip);
 
     web::AsyncWebRequest()
         .join("loader-update-download")
         .fetch(url)
-        .into(updateZip)
-        .then([this, updateZip, targetDir](auto) {
+        .into(*sink)
+        .then([this, updateZip, targetDir, sink](auto) {
+            log::debug("Downloaded loader update (SHA3-256 {})", sink->finish());
+            if (!*sink) {
+                LoaderUpdateEvent(
+                    UpdateFailed("Unable to write downloaded update")
+                ).post();
+                return;
+            }
+
             // unzip resources zip
             auto unzip = file::Unzip::intoDir(updateZip, targetDir, true);
             if (!unzip) {
@@ -684,7 +1031,8 @@ void Loader::Impl::downloadLoaderUpdate(std::string const& url) {
             m_isNewUpdateDownloaded = true;
             LoaderUpdateEvent(UpdateFinished()).post();
         })
-        .expect([](std::string const& info) {
+        .expect([sink](std::string const& info) {
+            sink->finish();
             LoaderUpdateEvent(
                 UpdateFailed("Unable to download update: " + info)
             ).post();
@@ -774,7 +1122,8 @@ json::Value Loader::Impl::processRawIPC(void* rawHandle, std::string const& buff
         data = json["data"];
     }
     // log::debug("Posting IPC event");
-    // ! warning: if the event system is ever made asynchronous this will break!
+    // ! warning: this has to be posted synchronously (not with postAsync) 
+    // ! since the reply is read right after
     IPCEvent(rawHandle, json["mod"].as_string(), json["message"].as_string(), data, reply).post();
     return reply;
 }
@@ -784,7 +1133,7 @@ ResourceDownloadEvent::ResourceDownloadEvent(
 ) : status(status) {}
 
 ListenerResult ResourceDownloadFilter::handle(
-    utils::MiniFunction<Callback> fn,
+    utils::MiniFunctionRef<Callback> fn,
     ResourceDownloadEvent* event
 ) {
     fn(event);
@@ -798,7 +1147,7 @@ LoaderUpdateEvent::LoaderUpdateEvent(
 ) : status(status) {}
 
 ListenerResult LoaderUpdateFilter::handle(
-    utils::MiniFunction<Callback> fn,
+    utils::MiniFunctionRef<Callback> fn,
     LoaderUpdateEvent* event
 ) {
     fn(event);
@@ -6,6 +6,7 @@
 #include <Geode/loader/Loader.hpp>
 #include <Geode/loader/Log.hpp>
 #include <Geode/loader/Mod.hpp>
+#include <Geode/loader/SettingEvent.hpp>
 #include <Geode/utils/Result.hpp>
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/ranges.hpp>
@@ -13,6 +14,7 @@
 #include "ModImpl.hpp"
 #include <about.hpp>
 #include <crashlog.hpp>
+#include <MPSCQueue.hpp>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -32,7 +34,7 @@ namespace geode {
     public:
         using Callback = void(ResourceDownloadEvent*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, ResourceDownloadEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, ResourceDownloadEvent* event);
         ResourceDownloadFilter();
     };
 
@@ -45,7 +47,7 @@ namespace geode {
     public:
         using Callback = void(LoaderUpdateEvent*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, LoaderUpdateEvent* event);
+        ListenerResult handle(utils::MiniFunctionRef<Callback> fn, LoaderUpdateEvent* event);
         LoaderUpdateFilter();
     };
 
@@ -68,11 +70,25 @@ namespace geode {
         std::condition_variable m_earlyLoadFinishedCV;
         std::mutex m_earlyLoadFinishedMutex;
         std::atomic_bool m_earlyLoadFinished = false;
-        std::vector<utils::MiniFunction<void(void)>> m_gdThreadQueue;
-        mutable std::mutex m_gdThreadMutex;
+        struct QueuedFunction {
+            ScheduledFunction func;
+            // the mod that queued the function, for profiling
+            Mod* mod;
+        };
+        MPSCQueue<QueuedFunction> m_gdThreadQueue;
         bool m_platformConsoleOpen = false;
+        // held while opening, closing or writing to the console, which the 
+        // log thread does too. Recursive as opening replays the log history
+        std::recursive_mutex m_platformConsoleMutex;
         std::vector<std::pair<Hook*, Mod*>> m_internalHooks;
         bool m_readyToHook = false;
+        // read from the loader's settings once on startup, as the hooks 
+        // enabled before that have been created with the normal detours
+        bool m_profileHooks = false;
+        // checked every frame, so it's looked up once
+        SettingHandle<bool> m_profileGDThreadQueue;
+        // the mods the "mod-log-levels" setting last gave an override to
+        std::vector<std::string> m_modLogLevels;
 
         std::mutex m_nextModMutex;
         std::unique_lock<std::mutex> m_nextModLock = std::unique_lock<std::mutex>(m_nextModMutex, std::defer_lock);
@@ -107,13 +123,17 @@ namespace geode {
         ~Impl();
 
         void createDirectories();
+        void cleanupModRuntimeDir();
 
         void updateModResources(Mod* mod);
         void addSearchPaths();
+        void updateLogLevels();
 
         friend void GEODE_CALL ::geode_implicit_load(Mod*);
 
         Result<Mod*> loadModFromInfo(ModInfo const& info);
+        Result<Mod*> createMod(ModInfo const& info);
+        Result<Mod*> addMod(Mod* mod);
 
         Result<> setup();
         void reset();
@@ -127,7 +147,17 @@ namespace geode {
         bool isModVersionSupported(VersionInfo const& version);
 
         Result<Mod*> loadModFromFile(ghc::filesystem::path const& file);
+        void findModFiles(
+            ghc::filesystem::path const& dir,
+            bool recursive,
+            std::unordered_set<std::string> const& loadedPaths,
+            std::vector<ghc::filesystem::path>& files
+        );
+        void loadModFiles(std::vector<ghc::filesystem::path> const& files);
+        std::unordered_set<std::string> getLoadedModPaths() const;
         void loadModsFromDirectory(ghc::filesystem::path const& dir, bool recursive = true);
+        std::vector<ModInfo> sortModsToLoad();
+        void loadModGroup(std::vector<ModInfo> const& infos);
         void refreshModsList();
         bool isModInstalled(std::string const& id) const;
         Mod* getInstalledMod(std::string const& id) const;
@@ -147,7 +177,7 @@ namespace geode {
 
         json::Value processRawIPC(void* rawHandle, std::string const& buffer);
 
-        void queueInGDThread(ScheduledFunction func);
+        void queueInGDThread(ScheduledFunction func, Mod* mod = getMod());
         void executeGDThreadQueue();
 
         void logConsoleMessage(std::string const& msg);
@@ -163,6 +193,7 @@ namespace geode {
         bool isNewUpdateDownloaded() const;
 
         bool isReadyToHook() const;
+        bool isProfilingHooks() const;
         void addInternalHook(Hook* hook, Mod* mod);
 
         Mod* createInternalMod();
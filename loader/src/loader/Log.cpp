@@ -5,9 +5,20 @@
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/casts.hpp>
 #include <Geode/utils/general.hpp>
+#include <binlog.hpp>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
 #include <iomanip>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace geode::prelude;
 using namespace geode::log;
@@ -93,12 +104,161 @@ std::string log::parse(gd::string const& str) {
 
 Log::Log(Mod* mod, Severity sev) : m_sender(mod), m_time(log_clock::now()), m_severity(sev) {}
 
+Log::Log(Mod* mod, Severity sev, std::string message) : Log(mod, sev) {
+    m_components.push_back(new ComponentBase(std::move(message)));
+}
+
+Log::Log(Mod* mod, Severity sev, std::string_view format, std::string packedArgs)
+  : Log(mod, sev, std::move(packedArgs)) {
+    m_format = format;
+}
+
+static void packType(std::string& packed, binlog::ArgType type) {
+    packed.push_back(static_cast<char>(type));
+}
+
+void log::packArgument(std::string& packed, std::string_view arg) {
+    packType(packed, binlog::ArgType::String);
+    binlog::writeString(packed, arg);
+}
+
+void log::packArgument(std::string& packed, CCPoint const& arg) {
+    packType(packed, binlog::ArgType::Point);
+    binlog::writeFloat(packed, arg.x);
+    binlog::writeFloat(packed, arg.y);
+}
+
+void log::packArgument(std::string& packed, CCSize const& arg) {
+    packType(packed, binlog::ArgType::Size);
+    binlog::writeFloat(packed, arg.width);
+    binlog::writeFloat(packed, arg.height);
+}
+
+void log::packArgument(std::string& packed, CCRect const& arg) {
+    packType(packed, binlog::ArgType::Rect);
+    binlog::writeFloat(packed, arg.origin.x);
+    binlog::writeFloat(packed, arg.origin.y);
+    binlog::writeFloat(packed, arg.size.width);
+    binlog::writeFloat(packed, arg.size.height);
+}
+
+void log::packArgument(std::string& packed, ccColor3B const& arg) {
+    packType(packed, binlog::ArgType::Color3B);
+    packed.push_back(static_cast<char>(arg.r));
+    packed.push_back(static_cast<char>(arg.g));
+    packed.push_back(static_cast<char>(arg.b));
+}
+
+void log::packArgument(std::string& packed, ccColor4B const& arg) {
+    packType(packed, binlog::ArgType::Color4B);
+    packed.push_back(static_cast<char>(arg.r));
+    packed.push_back(static_cast<char>(arg.g));
+    packed.push_back(static_cast<char>(arg.b));
+    packed.push_back(static_cast<char>(arg.a));
+}
+
+void log::packArgument(std::string& packed, ccColor4F const& arg) {
+    packType(packed, binlog::ArgType::Color4F);
+    binlog::writeFloat(packed, arg.r);
+    binlog::writeFloat(packed, arg.g);
+    binlog::writeFloat(packed, arg.b);
+    binlog::writeFloat(packed, arg.a);
+}
+
+// the object may be gone by the time the log is read, so everything parse() 
+// would show is packed now
+void log::packArgument(std::string& packed, CCObject* arg) {
+    if (!arg) {
+        return packArgument(packed, "{ CCObject, null }");
+    }
+    packType(packed, binlog::ArgType::Object);
+    binlog::writeString(packed, typeid(*arg).name());
+    binlog::writeVarint(packed, reinterpret_cast<uintptr_t>(arg));
+}
+
+void log::packArgument(std::string& packed, CCNode* arg) {
+    if (!arg) {
+        return packArgument(packed, "{ CCNode, null }");
+    }
+    auto bb = arg->boundingBox();
+    packType(packed, binlog::ArgType::Node);
+    binlog::writeString(packed, typeid(*arg).name());
+    binlog::writeVarint(packed, reinterpret_cast<uintptr_t>(arg));
+    binlog::writeFloat(packed, bb.origin.x);
+    binlog::writeFloat(packed, bb.origin.y);
+    binlog::writeFloat(packed, bb.size.width);
+    binlog::writeFloat(packed, bb.size.height);
+}
+
+void log::packArgument(std::string& packed, Mod* arg) {
+    if (!arg) {
+        return packArgument(packed, "{ Mod, null }");
+    }
+    packType(packed, binlog::ArgType::Mod);
+    binlog::writeString(packed, arg->getName());
+}
+
+void log::packSigned(std::string& packed, int64_t arg) {
+    packType(packed, binlog::ArgType::Signed);
+    binlog::writeVarint(packed, (static_cast<uint64_t>(arg) << 1) ^ static_cast<uint64_t>(arg >> 63));
+}
+
+void log::packUnsigned(std::string& packed, uint64_t arg) {
+    packType(packed, binlog::ArgType::Unsigned);
+    binlog::writeVarint(packed, arg);
+}
+
+void log::packFloat(std::string& packed, double arg) {
+    packType(packed, binlog::ArgType::Float);
+    binlog::writeFloat(packed, arg);
+}
+
+void log::packBool(std::string& packed, bool arg) {
+    packType(packed, binlog::ArgType::Bool);
+    packed.push_back(arg ? 1 : 0);
+}
+
+void log::packChar(std::string& packed, char arg) {
+    packType(packed, binlog::ArgType::Char);
+    packed.push_back(arg);
+}
+
+Log::Log(Log const& other)
+  : m_sender(other.m_sender), m_time(other.m_time), m_severity(other.m_severity),
+    m_format(other.m_format) {
+    for (auto comp : other.m_components) {
+        m_components.push_back(new ComponentBase(comp->_toString()));
+    }
+}
+
 Log::~Log() {
     for (auto comp : m_components) {
         delete comp;
     }
 }
 
+Log& Log::operator=(Log const& other) {
+    if (this != &other) {
+        *this = Log(other);
+    }
+    return *this;
+}
+
+Log& Log::operator=(Log&& other) {
+    if (this != &other) {
+        for (auto comp : m_components) {
+            delete comp;
+        }
+        m_sender = other.m_sender;
+        m_time = other.m_time;
+        m_components = std::move(other.m_components);
+        m_severity = other.m_severity;
+        m_format = other.m_format;
+        other.m_components.clear();
+    }
+    return *this;
+}
+
 bool Log::operator==(Log const& l) {
     return this == &l;
 }
@@ -112,6 +272,12 @@ std::string Log::toString(bool logTime) const {
 
     res += fmt::format(" [{}]: ", m_sender ? m_sender->getName() : "Geode?");
 
+    if (m_format.size()) {
+        auto packed = static_cast<ComponentBase<std::string>*>(m_components.front());
+        res += binlog::format(m_format, binlog::readArguments(packed->m_item));
+        return res;
+    }
+
     for (auto& i : m_components) {
         res += i->_toString();
     }
@@ -135,6 +301,19 @@ Severity Log::getSeverity() const {
     return m_severity;
 }
 
+std::string_view Log::getFormat() const {
+    return m_format;
+}
+
+void Log::unpack() {
+    if (m_format.empty()) {
+        return;
+    }
+    auto packed = static_cast<ComponentBase<std::string>*>(m_components.front());
+    packed->m_item = binlog::format(m_format, binlog::readArguments(packed->m_item));
+    m_format = std::string_view();
+}
+
 void Log::addFormat(std::string_view formatStr, std::span<ComponentTrait*> components) {
     auto res = this->addFormatNew(formatStr, components);
     if (res.isErr()) {
@@ -197,43 +376,557 @@ Result<> Log::addFormatNew(std::string_view formatStr, std::span<ComponentTrait*
 
 // Logger
 
-std::vector<Log>& Logger::logs() {
-    static std::vector<Log> logs;
-    return logs;
-}
-std::ofstream& Logger::logStream() {
-    static std::ofstream logStream;
-    return logStream;
+namespace {
+    // Logs are handed off to a background thread that formats them and writes 
+    // them to the console and log file, so logging doesn't stall the thread 
+    // doing it. Every thread that logs gets its own single-producer 
+    // single-consumer ring, so pushing a log never takes a lock
+    struct LogRing {
+        static constexpr size_t CAPACITY = 1024;
+
+        std::array<std::optional<Log>, CAPACITY> slots;
+        // next slot to read, only written by the writer thread
+        std::atomic<size_t> head = 0;
+        // next slot to write, only written by the owning thread
+        std::atomic<size_t> tail = 0;
+        // set once the owning thread has exited
+        std::atomic<bool> abandoned = false;
+
+        bool push(Log&& log) {
+            auto tail = this->tail.load(std::memory_order_relaxed);
+            if (tail - head.load(std::memory_order_acquire) == CAPACITY) {
+                return false;
+            }
+            slots[tail % CAPACITY].emplace(std::move(log));
+            this->tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool empty() const {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+
+        template <class F>
+        void drain(F&& func) {
+            auto head = this->head.load(std::memory_order_relaxed);
+            auto tail = this->tail.load(std::memory_order_acquire);
+            for (; head != tail; head++) {
+                auto& slot = slots[head % CAPACITY];
+                func(std::move(*slot));
+                slot.reset();
+            }
+            this->head.store(head, std::memory_order_release);
+        }
+    };
+
+    // Writes logs in the format described in binlog.hpp. Mods and format 
+    // strings are written out the first time they're seen and referred to by 
+    // index after that. Mods are told apart by ID, as the address of an 
+    // unloaded mod can be reused, and formats by address since packed logs 
+    // have been given an interned copy by Logger::push
+    struct BinaryLogFile {
+        std::ofstream stream;
+        std::string buffer;
+        std::unordered_map<std::string, uint64_t> mods;
+        std::unordered_map<char const*, uint64_t> formats;
+        log_clock::time_point last;
+
+        BinaryLogFile(ghc::filesystem::path const& path, log_clock::time_point start)
+          : stream(path, std::ios::binary), last(start) {
+            buffer += binlog::MAGIC;
+            buffer.push_back(static_cast<char>(binlog::VERSION));
+            binlog::writeVarint(buffer, std::chrono::duration_cast<std::chrono::microseconds>(
+                last.time_since_epoch()
+            ).count());
+        }
+
+        uint64_t modIndex(Mod* mod) {
+            auto [it, inserted] = mods.try_emplace(mod ? mod->getID() : "", mods.size());
+            if (inserted) {
+                buffer.push_back(static_cast<char>(binlog::RecordType::Mod));
+                binlog::writeVarint(buffer, it->second);
+                binlog::writeString(buffer, mod ? mod->getID() : "");
+                binlog::writeString(buffer, mod ? mod->getName() : "Geode?");
+            }
+            return it->second;
+        }
+
+        uint64_t formatIndex(std::string_view format) {
+            auto [it, inserted] = formats.try_emplace(format.data(), formats.size());
+            if (inserted) {
+                buffer.push_back(static_cast<char>(binlog::RecordType::Format));
+                binlog::writeVarint(buffer, it->second);
+                binlog::writeString(buffer, format);
+            }
+            return it->second;
+        }
+
+        void write(Log& log) {
+            static constexpr std::string_view PLAIN_FORMAT = "{}";
+
+            auto mod = this->modIndex(log.getSender());
+            auto message = static_cast<ComponentBase<std::string>*>(log.getComponents().front());
+            auto format = this->formatIndex(log.getFormat().size() ? log.getFormat() : PLAIN_FORMAT);
+
+            // logs from a later batch can be a bit older than the last one 
+            // written, those just get the same time
+            auto delta = std::chrono::duration_cast<std::chrono::microseconds>(log.getTime() - last);
+            if (delta.count() > 0) {
+                last += delta;
+            }
+
+            buffer.push_back(static_cast<char>(binlog::RecordType::Log));
+            binlog::writeVarint(buffer, std::max<int64_t>(delta.count(), 0));
+            binlog::writeVarint(buffer, mod);
+            buffer.push_back(static_cast<char>(log.getSeverity().m_value));
+            binlog::writeVarint(buffer, format);
+            if (log.getFormat().size()) {
+                binlog::writeString(buffer, message->m_item);
+            }
+            else {
+                std::string packed;
+                packArgument(packed, message->m_item);
+                binlog::writeString(buffer, packed);
+            }
+        }
+
+        void flush() {
+            stream.write(buffer.data(), buffer.size());
+            stream.flush();
+            buffer.clear();
+        }
+    };
+
+    struct LogWriter {
+        // timed so the crash handler can give up on them, see drainNow
+        std::timed_mutex ringsMutex;
+        std::vector<std::shared_ptr<LogRing>> rings;
+
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::atomic<bool> pending = false;
+        // number of passes the writer has started and finished, used by 
+        // flush to wait for everything pushed before it to be written
+        size_t passesStarted = 0;
+        size_t passesFinished = 0;
+        std::condition_variable written;
+        std::atomic<bool> started = false;
+
+        std::mutex historyMutex;
+        std::deque<Log> history;
+        size_t historyLimit = 10000;
+        // whether any log has been dropped from the history yet
+        bool historyTrimmed = false;
+
+        std::timed_mutex streamMutex;
+        ghc::filesystem::path streamPath;
+        std::ofstream stream;
+        std::unique_ptr<BinaryLogFile> binary;
+        std::atomic<bool> binaryEnabled = false;
+
+        static LogWriter& get() {
+            static auto inst = new LogWriter();
+            return *inst;
+        }
+
+        std::shared_ptr<LogRing> ring() {
+            // the ring outlives the thread until the writer has emptied it
+            struct Owner {
+                std::shared_ptr<LogRing> ring;
+                ~Owner() {
+                    if (ring) {
+                        ring->abandoned = true;
+                    }
+                }
+            };
+            static thread_local Owner owner;
+            if (!owner.ring) {
+                owner.ring = std::make_shared<LogRing>();
+                std::lock_guard lock(ringsMutex);
+                rings.push_back(owner.ring);
+            }
+            return owner.ring;
+        }
+
+        void notify() {
+            if (!pending.exchange(true)) {
+                std::lock_guard lock(wakeMutex);
+                wake.notify_one();
+            }
+        }
+
+        void push(Log&& log) {
+            if (!started.load(std::memory_order_relaxed)) {
+                this->start();
+            }
+            auto ring = this->ring();
+            auto severity = log.getSeverity();
+            while (!ring->push(std::move(log))) {
+                // the ring is full, so wait for the writer to catch up
+                this->notify();
+                std::this_thread::yield();
+            }
+            // errors wake the writer right away, everything else is picked up 
+            // by its next batch. If the game crashes before then, the crash 
+            // handler writes what's left with drain
+            if (severity >= Severity::Error) {
+                this->notify();
+            }
+        }
+
+        void start() {
+            std::lock_guard lock(wakeMutex);
+            if (started) {
+                return;
+            }
+            started = true;
+            std::thread([this] {
+                this->run();
+            }).detach();
+        }
+
+        void run() {
+            std::vector<Log> batch;
+            while (true) {
+                {
+                    std::unique_lock lock(wakeMutex);
+                    // flush about 10 times a second even if nobody asks
+                    wake.wait_for(lock, std::chrono::milliseconds(100), [this] {
+                        return pending.load();
+                    });
+                    pending = false;
+                    passesStarted += 1;
+                }
+
+                {
+                    std::lock_guard lock(ringsMutex);
+                    this->collect(batch);
+                }
+
+                if (batch.size()) {
+                    // the console is held until the batch is in the history, 
+                    // so a console opened meanwhile gets each log exactly once, 
+                    // either printed here or replayed from the history
+                    std::lock_guard consoleLock(LoaderImpl::get()->m_platformConsoleMutex);
+                    {
+                        std::lock_guard lock(streamMutex);
+                        this->write(batch, true);
+                    }
+                    std::lock_guard lock(historyMutex);
+                    for (auto& log : batch) {
+                        history.push_back(std::move(log));
+                    }
+                    while (history.size() > historyLimit) {
+                        history.pop_front();
+                        historyTrimmed = true;
+                    }
+                }
+                batch.clear();
+
+                {
+                    std::lock_guard lock(wakeMutex);
+                    passesFinished = passesStarted;
+                }
+                written.notify_all();
+            }
+        }
+
+        // ringsMutex must be held
+        void collect(std::vector<Log>& batch) {
+            for (auto& ring : rings) {
+                ring->drain([&](Log&& log) {
+                    batch.push_back(std::move(log));
+                });
+            }
+            std::erase_if(rings, [](auto const& ring) {
+                return ring->abandoned && ring->empty();
+            });
+            // logs from different threads are interleaved by time
+            std::stable_sort(batch.begin(), batch.end(), [](Log const& a, Log const& b) {
+                return a.getTime() < b.getTime();
+            });
+        }
+
+        // streamMutex must be held. In binary mode, logs are only put into 
+        // text if the console is open; the history keeps them packed
+        void write(std::vector<Log>& batch, bool console) {
+            console = console && LoaderImpl::get()->platformConsoleOpen();
+            for (auto& log : batch) {
+                if (binary) {
+                    binary->write(log);
+                    if (!console) {
+                        continue;
+                    }
+                }
+                auto str = log.toString(true);
+                if (console) {
+                    LoaderImpl::get()->logConsoleMessageWithSeverity(str, log.getSeverity());
+                }
+                if (!binary) {
+                    stream << str << '\n';
+                }
+            }
+            if (binary) {
+                binary->flush();
+            }
+            else {
+                stream.flush();
+            }
+        }
+
+        // Called by the crash handler on the crashing thread. The writer 
+        // thread may never run again, so whatever is still queued is written 
+        // to the log file right here. The locks are only waited on briefly, 
+        // since the crash may have happened while one of them was held
+        void drainNow() {
+            static constexpr auto TIMEOUT = std::chrono::milliseconds(200);
+
+            std::vector<Log> batch;
+            {
+                std::unique_lock lock(ringsMutex, TIMEOUT);
+                if (!lock.owns_lock()) {
+                    return;
+                }
+                this->collect(batch);
+            }
+            if (batch.empty()) {
+                return;
+            }
+            std::unique_lock lock(streamMutex, TIMEOUT);
+            if (lock.owns_lock()) {
+                this->write(batch, false);
+            }
+        }
+
+        void flush() {
+            std::unique_lock lock(wakeMutex);
+            if (!started) {
+                return;
+            }
+            // wait for a full pass that starts after this call
+            auto target = passesStarted + 1;
+            pending = true;
+            wake.notify_one();
+            written.wait(lock, [&] {
+                return passesFinished >= target;
+            });
+        }
+    };
 }
 
 void Logger::setup() {
-    logStream() = std::ofstream(dirs::getGeodeLogDir() / log::generateLogName());
+    auto& writer = LogWriter::get();
+    std::lock_guard lock(writer.streamMutex);
+    writer.streamPath = dirs::getGeodeLogDir() / log::generateLogName();
+    writer.stream = std::ofstream(writer.streamPath);
+}
+
+// Format strings are literals in the logging mod's binary, which may be 
+// unloaded while its logs are still queued, so packed logs refer to a copy 
+// owned by the loader instead. Each thread remembers the copies it has 
+// already looked up; the contents are compared as well in case another 
+// binary has been loaded at the address of an unloaded one
+static std::string_view internFormat(std::string_view format) {
+    static thread_local std::unordered_map<char const*, std::string_view> seen;
+    auto it = seen.find(format.data());
+    if (it != seen.end() && it->second == format) {
+        return it->second;
+    }
+
+    static std::mutex mutex;
+    // node-based, so the copies never move
+    static std::unordered_set<std::string> formats;
+    std::string_view interned;
+    {
+        std::lock_guard lock(mutex);
+        interned = *formats.emplace(format).first;
+    }
+    seen[format.data()] = interned;
+    return interned;
+}
+
+static thread_local std::vector<Log>* s_capturedLogs = nullptr;
+
+void Logger::captureThread(std::vector<Log>* buffer) {
+    s_capturedLogs = buffer;
 }
 
 void Logger::push(Log&& log) {
-    std::string logStr = log.toString(true);
+    if (log.m_format.size()) {
+        log.m_format = internFormat(log.m_format);
+    }
 
-    LoaderImpl::get()->logConsoleMessageWithSeverity(logStr, log.getSeverity());
-    logStream() << logStr << std::endl;
+    // components may point to objects that are gone by the time the writer 
+    // gets to the log, so they are turned into a string right away, unless 
+    // internalLog already did that
+    if (!(
+        log.m_components.size() == 1 &&
+        dynamic_cast<ComponentBase<std::string>*>(log.m_components.front())
+    )) {
+        std::string message;
+        for (auto comp : log.m_components) {
+            message += comp->_toString();
+            delete comp;
+        }
+        log.m_components = { new ComponentBase(std::move(message)) };
+    }
 
-    logs().emplace_back(std::forward<Log>(log));
+    if (s_capturedLogs) {
+        s_capturedLogs->push_back(std::move(log));
+        return;
+    }
+    LogWriter::get().push(std::move(log));
 }
 
 void Logger::pop(Log* log) {
-    geode::utils::ranges::remove(Logger::logs(), *log);
+    auto& writer = LogWriter::get();
+    std::lock_guard lock(writer.historyMutex);
+    for (auto it = writer.history.begin(); it != writer.history.end(); it++) {
+        if (&*it == log) {
+            writer.history.erase(it);
+            break;
+        }
+    }
 }
 
 std::vector<Log*> Logger::list() {
-    std::vector<Log*> logs_;
-    logs_.reserve(logs().size());
-    for (auto& log : logs()) {
-        logs_.push_back(&log);
+    auto& writer = LogWriter::get();
+    std::lock_guard lock(writer.historyMutex);
+    // the history is a deque, so these stay valid until the logs are dropped 
+    // from it
+    std::vector<Log*> logs;
+    logs.reserve(writer.history.size());
+    for (auto& log : writer.history) {
+        logs.push_back(&log);
+    }
+    return logs;
+}
+
+std::vector<Log> Logger::listCopies() {
+    auto& writer = LogWriter::get();
+    std::unique_lock lock(writer.historyMutex);
+    // copies, since the writer drops the oldest logs from the history 
+    // as new ones come in
+    std::vector<Log> logs(writer.history.begin(), writer.history.end());
+    lock.unlock();
+    for (auto& log : logs) {
+        log.unpack();
     }
-    return logs_;
+    return logs;
 }
 
 void Logger::clear() {
-    logs().clear();
+    auto& writer = LogWriter::get();
+    std::lock_guard lock(writer.historyMutex);
+    writer.history.clear();
+}
+
+void Logger::flush() {
+    LogWriter::get().flush();
+}
+
+void Logger::drain() {
+    LogWriter::get().drainNow();
+}
+
+void Logger::setHistoryLimit(size_t limit) {
+    auto& writer = LogWriter::get();
+    std::lock_guard lock(writer.historyMutex);
+    writer.historyLimit = limit;
+    while (writer.history.size() > limit) {
+        writer.history.pop_front();
+        writer.historyTrimmed = true;
+    }
+}
+
+size_t Logger::getHistoryLimit() {
+    auto& writer = LogWriter::get();
+    std::lock_guard lock(writer.historyMutex);
+    return writer.historyLimit;
+}
+
+static std::atomic<Severity::type> s_minSeverity = Severity::Debug;
+
+void Logger::setMinSeverity(Severity severity) {
+    s_minSeverity = severity.m_value;
+}
+
+Severity Logger::getMinSeverity() {
+    return s_minSeverity.load(std::memory_order_relaxed);
+}
+
+// the overrides are keyed by ID rather than Mod* so they can be set before 
+// the mod is loaded, and so the flag keeps the lookup off the path of every 
+// log when there are none
+static std::mutex s_modMinSeverityMutex;
+static std::unordered_map<std::string, Severity::type> s_modMinSeverities;
+static std::atomic<bool> s_hasModMinSeverities = false;
+
+void Logger::setMinSeverity(std::string const& modID, std::optional<Severity> severity) {
+    std::lock_guard lock(s_modMinSeverityMutex);
+    if (severity) {
+        s_modMinSeverities[modID] = severity->m_value;
+    }
+    else {
+        s_modMinSeverities.erase(modID);
+    }
+    s_hasModMinSeverities = !s_modMinSeverities.empty();
+}
+
+Severity Logger::getMinSeverity(Mod* mod) {
+    if (mod && s_hasModMinSeverities.load(std::memory_order_relaxed)) {
+        auto id = mod->getID();
+        std::lock_guard lock(s_modMinSeverityMutex);
+        if (auto it = s_modMinSeverities.find(id); it != s_modMinSeverities.end()) {
+            return it->second;
+        }
+    }
+    return getMinSeverity();
+}
+
+void Logger::setBinarySink(bool enabled) {
+    auto& writer = LogWriter::get();
+    // same order as the writer, which holds the console until a batch it has 
+    // written is in the history
+    std::lock_guard consoleLock(LoaderImpl::get()->m_platformConsoleMutex);
+    std::lock_guard lock(writer.streamMutex);
+    std::lock_guard historyLock(writer.historyMutex);
+
+    // packed logs that are still queued when this is turned off are simply 
+    // put into text for the text log
+    if (enabled && !writer.binary) {
+        auto start = writer.history.size() ? writer.history.front().getTime() : log_clock::now();
+        auto path = writer.streamPath.empty() ?
+            dirs::getGeodeLogDir() / log::generateLogName() :
+            writer.streamPath;
+        writer.binary = std::make_unique<BinaryLogFile>(path.replace_extension(".glog"), start);
+
+        // the logs from before the setting was read have gone to the text 
+        // log, so they're moved over to keep the session in one file. If 
+        // some of them are no longer in the history, the text log is kept
+        for (auto& log : writer.history) {
+            writer.binary->write(log);
+        }
+        writer.binary->flush();
+        writer.stream.close();
+        if (!writer.historyTrimmed && !writer.streamPath.empty()) {
+            std::error_code ec;
+            ghc::filesystem::remove(writer.streamPath, ec);
+        }
+    }
+    else if (!enabled && writer.binary) {
+        writer.binary->flush();
+        writer.binary.reset();
+        if (!writer.stream.is_open()) {
+            writer.streamPath = dirs::getGeodeLogDir() / log::generateLogName();
+            writer.stream = std::ofstream(writer.streamPath);
+        }
+    }
+    writer.binaryEnabled = enabled;
+}
+
+bool Logger::hasBinarySink() {
+    return LogWriter::get().binaryEnabled.load(std::memory_order_relaxed);
 }
 
 // Misc
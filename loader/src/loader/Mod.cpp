@@ -128,6 +128,10 @@ Result<> Mod::enableHook(Hook* hook) {
     return m_impl->enableHook(hook);
 }
 
+Result<> Mod::enableHooks(std::span<Hook* const> hooks) {
+    return m_impl->enableHooks(hooks);
+}
+
 Result<> Mod::disableHook(Hook* hook) {
     return m_impl->disableHook(hook);
 }
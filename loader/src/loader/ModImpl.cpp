@@ -1,4 +1,5 @@
 #include "ModImpl.hpp"
+#include "HookImpl.hpp"
 #include "LoaderImpl.hpp"
 #include "ModInfoImpl.hpp"
 #include "about.hpp"
@@ -10,7 +11,10 @@
 #include <Geode/loader/Mod.hpp>
 #include <Geode/loader/ModEvent.hpp>
 #include <Geode/utils/file.hpp>
+#include <Geode/utils/string.hpp>
+#include <Geode/utils/timer.hpp>
 #include <Geode/utils/JsonValidation.hpp>
+#include <hash.hpp>
 #include <optional>
 #include <string>
 #include <vector>
@@ -37,7 +41,9 @@ Result<> Mod::Impl::setup() {
     ghc::filesystem::create_directories(m_saveDirPath);
     
     this->setupSettings();
-    auto loadRes = this->loadData();
+    // mods are set up on worker threads, so the DataLoaded event is queued 
+    // by the loader in load order instead
+    auto loadRes = this->readData();
     if (!loadRes) {
         log::warn("Unable to load data for \"{}\": {}", m_info.id(), loadRes.unwrapErr());
     }
@@ -123,8 +129,11 @@ std::vector<Hook*> Mod::Impl::getHooks() const {
 Result<> Mod::Impl::loadData() {
     Loader::get()->queueInGDThread([&]() {
         ModStateEvent(m_self, ModEventType::DataLoaded).post();
-    });
+    }, Mod::get());
+    return this->readData();
+}
 
+Result<> Mod::Impl::readData() {
     // Settings
     // Check if settings exist
     auto settingPath = m_saveDirPath / "settings.json";
@@ -201,7 +210,7 @@ Result<> Mod::Impl::saveData() {
     for (auto& [key, value] : m_settings) {
         coveredSettings.insert(key);
         if (!value->save(json[key])) {
-            log::error("Unable to save setting \"" + key + "\"");
+            log::error("Unable to save setting \"{}\"", key);
         }
     }
 
@@ -307,7 +316,9 @@ Result<> Mod::Impl::loadBinary() {
 
     LoaderImpl::get()->provideNextMod(m_self);
 
+    m_loadingBinary = true;
     auto res = this->loadPlatformBinary();
+    m_loadingBinary = false;
     if (!res) {
         // make sure to free up the next mod mutex
         LoaderImpl::get()->releaseNextMod();
@@ -320,7 +331,7 @@ Result<> Mod::Impl::loadBinary() {
 
     Loader::get()->queueInGDThread([&]() {
         ModStateEvent(m_self, ModEventType::Loaded).post();
-    });
+    }, Mod::get());
 
     Loader::get()->updateAllDependencies();
     if (LoaderImpl::get()->m_isSetup) {
@@ -347,7 +358,7 @@ Result<> Mod::Impl::unloadBinary() {
     GEODE_UNWRAP(this->disable());
     Loader::get()->queueInGDThread([&]() {
         ModStateEvent(m_self, ModEventType::Unloaded).post();
-    });
+    }, Mod::get());
 
     // Disabling unhooks and unpatches already
     for (auto const& hook : m_hooks) {
@@ -373,15 +384,30 @@ Result<> Mod::Impl::enable() {
         return this->loadBinary();
     }
 
+    std::vector<Hook*> hooks;
+    hooks.reserve(m_hooks.size());
     for (auto const& hook : m_hooks) {
         if (!hook) {
             log::warn("Hook is null in mod \"{}\"", m_info.name());
             continue;
         }
         if (hook->getAutoEnable()) {
-            GEODE_UNWRAP(this->enableHook(hook));
+            hooks.push_back(hook);
         }
     }
+    utils::Timer<std::chrono::steady_clock> timer;
+    // like patches, hooks that fail are skipped rather than failing the 
+    // load, since the binary is loaded and the rest of its hooks are active 
+    // by now
+    auto failed = Hook::Impl::enableAll(hooks);
+    for (auto const& [hook, err] : failed) {
+        log::error("Can't enable hook {} for mod {}: {}", hook->getDisplayName(), m_info.id(), err);
+    }
+    log::debug(
+        "Enabled {} hooks for {} in {}",
+        hooks.size() - failed.size(), m_info.id(),
+        timer.elapsedAsString<std::chrono::microseconds>()
+    );
 
     for (auto const& patch : m_patches) {
         if (!patch->apply()) {
@@ -392,7 +418,7 @@ Result<> Mod::Impl::enable() {
 
     Loader::get()->queueInGDThread([&]() {
         ModStateEvent(m_self, ModEventType::Enabled).post();
-    });
+    }, Mod::get());
     m_enabled = true;
 
     return Ok();
@@ -408,7 +434,7 @@ Result<> Mod::Impl::disable() {
 
     Loader::get()->queueInGDThread([&]() {
         ModStateEvent(m_self, ModEventType::Disabled).post();
-    });
+    }, Mod::get());
 
     for (auto const& hook : m_hooks) {
         GEODE_UNWRAP(this->disableHook(hook));
@@ -532,6 +558,17 @@ Result<> Mod::Impl::enableHook(Hook* hook) {
     return res;
 }
 
+Result<> Mod::Impl::enableHooks(std::span<Hook* const> hooks) {
+    auto failed = Hook::Impl::enableAll(hooks);
+    for (auto const& [hook, err] : failed) {
+        log::error("Can't enable hook {} for mod {}: {}", hook->getDisplayName(), m_info.id(), err);
+    }
+    if (failed.size()) {
+        return Err("Unable to enable {} hooks", failed.size());
+    }
+    return Ok();
+}
+
 Result<> Mod::Impl::disableHook(Hook* hook) {
     return hook->disable();
 }
@@ -539,7 +576,9 @@ Result<> Mod::Impl::disableHook(Hook* hook) {
 Result<Hook*> Mod::Impl::addHook(Hook* hook) {
     m_hooks.push_back(hook);
     if (LoaderImpl::get()->isReadyToHook()) {
-        if (hook->getAutoEnable()) {
+        // hooks added by the mod's binary while it's loading are enabled in 
+        // one batch by enable()
+        if (hook->getAutoEnable() && !m_loadingBinary) {
             auto res = this->enableHook(hook);
             if (!res) {
                 delete hook;
@@ -599,6 +638,45 @@ Result<> Mod::Impl::unpatch(Patch* patch) {
 
 // Misc.
 
+// Every unzipped mod directory contains a stamp describing the .geode file 
+// it was extracted from, so unchanged mods don't have to be extracted again 
+// on every launch
+static constexpr auto UNZIP_STAMP_FILE = ".geode-unzip-stamp";
+
+struct UnzipStamp {
+    uintmax_t size;
+    int64_t modifiedTime;
+    std::string hash;
+};
+
+static std::optional<UnzipStamp> readUnzipStamp(ghc::filesystem::path const& dir) {
+    auto data = file::readString(dir / UNZIP_STAMP_FILE);
+    if (!data) {
+        return std::nullopt;
+    }
+    auto parts = string::split(data.unwrap(), "\n");
+    if (parts.size() != 3) {
+        return std::nullopt;
+    }
+    try {
+        return UnzipStamp {
+            .size = std::stoull(parts[0]),
+            .modifiedTime = std::stoll(parts[1]),
+            .hash = parts[2],
+        };
+    }
+    catch(...) {
+        return std::nullopt;
+    }
+}
+
+static Result<> writeUnzipStamp(ghc::filesystem::path const& dir, UnzipStamp const& stamp) {
+    return file::writeString(
+        dir / UNZIP_STAMP_FILE,
+        fmt::format("{}\n{}\n{}", stamp.size, stamp.modifiedTime, stamp.hash)
+    );
+}
+
 Result<> Mod::Impl::createTempDir() {
     // Check if temp dir already exists
     if (!m_tempDirName.string().empty()) {
@@ -611,20 +689,63 @@ Result<> Mod::Impl::createTempDir() {
         return Err("Unable to create mods' runtime directory");
     }
 
-    // Create geode/temp/mod.id
     auto tempPath = tempDir / m_info.id();
-    if (!file::createDirectoryAll(tempPath)) {
-        return Err("Unable to create mod runtime directory");
+
+    // Check if the .geode file has already been unzipped on a previous launch
+    std::error_code sizeErr, timeErr;
+    UnzipStamp current {
+        .size = ghc::filesystem::file_size(m_info.path(), sizeErr),
+        .modifiedTime = static_cast<int64_t>(
+            ghc::filesystem::last_write_time(m_info.path(), timeErr)
+                .time_since_epoch().count()
+        ),
+    };
+    bool upToDate = false;
+    auto stamp = readUnzipStamp(tempPath);
+    if (
+        stamp && !sizeErr && !timeErr && stamp->size == current.size &&
+        ghc::filesystem::exists(tempPath / m_info.binaryName())
+    ) {
+        if (stamp->modifiedTime == current.modifiedTime) {
+            upToDate = true;
+        }
+        // the file may have been replaced with an identical copy
+        else if (stamp->hash == ::calculateHash(m_info.path())) {
+            upToDate = true;
+            current.hash = stamp->hash;
+            (void)writeUnzipStamp(tempPath, current);
+        }
     }
 
-    // Unzip .geode file into temp dir
-    GEODE_UNWRAP_INTO(auto unzip, file::Unzip::create(m_info.path()));
-    if (!unzip.hasEntry(m_info.binaryName())) {
-        return Err(
-            fmt::format("Unable to find platform binary under the name \"{}\"", m_info.binaryName())
-        );
+    if (!upToDate) {
+        // Clear out files left over from an older version
+        try {
+            ghc::filesystem::remove_all(tempPath);
+        }
+        catch(...) {
+            return Err("Unable to clear old mod runtime directory");
+        }
+
+        // Create geode/temp/mod.id
+        if (!file::createDirectoryAll(tempPath)) {
+            return Err("Unable to create mod runtime directory");
+        }
+
+        // Unzip .geode file into temp dir
+        GEODE_UNWRAP_INTO(auto unzip, file::Unzip::create(m_info.path()));
+        if (!unzip.hasEntry(m_info.binaryName())) {
+            return Err(
+                fmt::format("Unable to find platform binary under the name \"{}\"", m_info.binaryName())
+            );
+        }
+        GEODE_UNWRAP(unzip.extractAllTo(tempPath));
+
+        // Only stamp the directory if we know what it was extracted from
+        if (!sizeErr && !timeErr) {
+            current.hash = ::calculateHash(m_info.path());
+            (void)writeUnzipStamp(tempPath, current);
+        }
     }
-    GEODE_UNWRAP(unzip.extractAllTo(tempPath));
 
     // Mark temp dir creation as succesful
     m_tempDirName = tempPath;
@@ -716,5 +837,8 @@ Mod* Loader::Impl::createInternalMod() {
 }
 
 Result<> Loader::Impl::setupInternalMod() {
+    this->queueInGDThread([]() {
+        ModStateEvent(Mod::get(), ModEventType::DataLoaded).post();
+    });
     return Mod::get()->m_impl->setup();
 }
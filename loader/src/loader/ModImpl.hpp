@@ -30,6 +30,11 @@ namespace geode {
          * Whether the mod binary is loaded or not
          */
         bool m_binaryLoaded = false;
+        /**
+         * Whether the mod binary is being loaded. Hooks added while loading 
+         * are enabled together once the binary has finished loading
+         */
+        bool m_loadingBinary = false;
         /**
          * Mod temp directory name
          */
@@ -94,6 +99,8 @@ namespace geode {
 
         Result<> saveData();
         Result<> loadData();
+        // loadData without posting the DataLoaded event
+        Result<> readData();
 
         ghc::filesystem::path getSaveDir() const;
         ghc::filesystem::path getConfigDir(bool create = true) const;
@@ -108,6 +115,7 @@ namespace geode {
         std::vector<Hook*> getHooks() const;
         Result<Hook*> addHook(Hook* hook);
         Result<> enableHook(Hook* hook);
+        Result<> enableHooks(std::span<Hook* const> hooks);
         Result<> disableHook(Hook* hook);
         Result<> removeHook(Hook* hook);
         Result<Patch*> patch(void* address, ByteVector const& data);
@@ -8,6 +8,8 @@
 #include <Geode/utils/general.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <re2/re2.h>
+#include <mutex>
+#include <unordered_map>
 
 using namespace geode::prelude;
 
@@ -58,10 +60,37 @@ Result<FloatSetting> FloatSetting::parse(JsonMaybeObject& obj) {
     return Ok(sett);
 }
 
+// Regexes are compiled once per pattern and shared by every setting that 
+// uses the same one, instead of being compiled on every validation
+static std::shared_ptr<re2::RE2> compilePattern(std::string const& pattern) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<re2::RE2>> patterns;
+    std::lock_guard lock(mutex);
+    auto& re = patterns[pattern];
+    if (!re) {
+        re = std::make_shared<re2::RE2>(pattern);
+    }
+    return re;
+}
+
+static bool matchesPattern(StringSetting const& sett, std::string const& value) {
+    if (!sett.match) {
+        return true;
+    }
+    if (sett.compiledMatch) {
+        return re2::RE2::FullMatch(value, *sett.compiledMatch);
+    }
+    // definitions that weren't made by parse haven't been compiled yet
+    return re2::RE2::FullMatch(value, *compilePattern(sett.match.value()));
+}
+
 Result<StringSetting> StringSetting::parse(JsonMaybeObject& obj) {
     StringSetting sett;
     parseCommon(sett, obj);
     obj.has("match").into(sett.match);
+    if (sett.match) {
+        sett.compiledMatch = compilePattern(sett.match.value());
+    }
     return Ok(sett);
 }
 
@@ -262,16 +291,6 @@ void SettingValue::valueChanged() {
         this->valueChanged();                                           \
     }                                                                   \
     template<>                                                          \
-    Result<> GeodeSettingValue<                                         \
-        type_##Setting                                                  \
-    >::validate(ValueType const& value) const {                         \
-        auto reason = this->toValid(value).second;                      \
-        if (reason.has_value()) {                                       \
-            return Err(static_cast<std::string>(reason.value()));       \
-        }                                                               \
-        return Ok();                                                    \
-    }                                                                   \
-    template<>                                                          \
     typename type_##Setting::ValueType SettingValueSetter<              \
         typename type_##Setting::ValueType                              \
     >::get(SettingValue* setting) {                                     \
@@ -292,6 +311,18 @@ void SettingValue::valueChanged() {
         }                                                               \
     }
 
+#define IMPL_VALIDATE(type_) \
+    template<>                                                          \
+    Result<> GeodeSettingValue<                                         \
+        type_##Setting                                                  \
+    >::validate(ValueType const& value) const {                         \
+        auto reason = this->toValid(value).second;                      \
+        if (reason.has_value()) {                                       \
+            return Err(static_cast<std::string>(reason.value()));       \
+        }                                                               \
+        return Ok();                                                    \
+    }
+
 #define IMPL_TO_VALID(type_) \
     template<>                                          \
     typename GeodeSettingValue<type_##Setting>::Valid   \
@@ -349,7 +380,7 @@ IMPL_TO_VALID(Float) {
 
 IMPL_TO_VALID(String) {
     if (m_definition.match) {
-        if (!re2::RE2::FullMatch(value, m_definition.match.value())) {
+        if (!matchesPattern(m_definition, value)) {
             return {
                 m_definition.defaultValue,
                 fmt::format(
@@ -382,6 +413,23 @@ IMPL_NODE_AND_SETTERS(File);
 IMPL_NODE_AND_SETTERS(Color);
 IMPL_NODE_AND_SETTERS(ColorAlpha);
 
+IMPL_VALIDATE(Bool);
+IMPL_VALIDATE(Int);
+IMPL_VALIDATE(Float);
+IMPL_VALIDATE(File);
+IMPL_VALIDATE(Color);
+IMPL_VALIDATE(ColorAlpha);
+
+// checked on every keystroke in the setting's input, so this avoids the 
+// copy of the value that toValid makes
+template<>
+Result<> GeodeSettingValue<StringSetting>::validate(ValueType const& value) const {
+    if (!matchesPattern(m_definition, value)) {
+        return Err("Value must match regex {}", m_definition.match.value());
+    }
+    return Ok();
+}
+
 // instantiate value setters
 
 namespace geode {
@@ -402,7 +450,7 @@ SettingChangedEvent::SettingChangedEvent(Mod* mod, SettingValue* value)
 // SettingChangedFilter
 
 ListenerResult SettingChangedFilter::handle(
-    utils::MiniFunction<Callback> fn, SettingChangedEvent* event
+    utils::MiniFunctionRef<Callback> fn, SettingChangedEvent* event
 ) {
     if (m_modID == event->mod->getID() &&
         (!m_targetKey || m_targetKey.value() == event->value->getKey())
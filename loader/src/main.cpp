@@ -110,6 +110,14 @@ $execute {
         }
     });
     
+    listenForSettingChanges("log-level", +[](std::string value) {
+        LoaderImpl::get()->updateLogLevels();
+    });
+
+    listenForSettingChanges("mod-log-levels", +[](std::string value) {
+        LoaderImpl::get()->updateLogLevels();
+    });
+    
     listenForIPC("ipc-test", [](IPCEvent* event) -> json::Value {
         return "Hello from Geode!";
     });
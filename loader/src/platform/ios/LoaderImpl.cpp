@@ -16,12 +16,14 @@ void Loader::Impl::platformMessageBox(char const* title, std::string const& info
 }
 
 void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severity severity) {
+    std::lock_guard lock(m_platformConsoleMutex);
     if (m_platformConsoleOpen) {
         std::cout << msg << "\n" << std::flush;
     }
 }
 
 void Loader::Impl::openPlatformConsole() {
+    std::lock_guard lock(m_platformConsoleMutex);
     ghc::filesystem::path(getpwuid(getuid())->pw_dir);
     freopen(ghc::filesystem::path(dirs::getGeodeDir() / "geode_log.txt").string().c_str(), "w", stdout);
     m_platformConsoleOpen = true;
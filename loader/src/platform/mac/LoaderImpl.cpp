@@ -20,6 +20,7 @@ void Loader::Impl::platformMessageBox(char const* title, std::string const& info
 }
 
 void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severity severity) {
+    std::lock_guard lock(m_platformConsoleMutex);
     if (m_platformConsoleOpen) {
         int colorcode = 0;
         switch (severity) {
@@ -36,14 +37,16 @@ void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severit
 }
 
 void Loader::Impl::openPlatformConsole() {
+    std::lock_guard lock(m_platformConsoleMutex);
     m_platformConsoleOpen = true;
 
-    for (auto const& log : log::Logger::list()) {
-        this->logConsoleMessageWithSeverity(log->toString(true), log->getSeverity());
+    for (auto const& log : log::Logger::listCopies()) {
+        this->logConsoleMessageWithSeverity(log.toString(true), log.getSeverity());
     }
 }
 
 void Loader::Impl::closePlatformConsole() {
+    std::lock_guard lock(m_platformConsoleMutex);
     m_platformConsoleOpen = false;
 }
 
@@ -20,6 +20,7 @@ void Loader::Impl::platformMessageBox(char const* title, std::string const& info
 bool hasAnsiColorSupport = false;
 
 void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severity severity) {
+    std::lock_guard lock(m_platformConsoleMutex);
     if (m_platformConsoleOpen) {
         if (hasAnsiColorSupport) {
             int color = 0;
@@ -41,6 +42,7 @@ void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severit
 }
 
 void Loader::Impl::openPlatformConsole() {
+    std::lock_guard lock(m_platformConsoleMutex);
     if (m_platformConsoleOpen) return;
     if (AllocConsole() == 0) return;
     SetConsoleCP(CP_UTF8);
@@ -61,12 +63,13 @@ void Loader::Impl::openPlatformConsole() {
 
     m_platformConsoleOpen = true;
 
-    for (auto const& log : log::Logger::list()) {
-        this->logConsoleMessageWithSeverity(log->toString(true), log->getSeverity());
+    for (auto const& log : log::Logger::listCopies()) {
+        this->logConsoleMessageWithSeverity(log.toString(true), log.getSeverity());
     }
 }
 
 void Loader::Impl::closePlatformConsole() {
+    std::lock_guard lock(m_platformConsoleMutex);
     if (!m_platformConsoleOpen) return;
 
     fclose(stdin);
@@ -7,6 +7,7 @@
 #include <crashlog.hpp>
 #include <Geode/loader/Dirs.hpp>
 #include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Log.hpp>
 #include <Geode/loader/Mod.hpp>
 #include <DbgHelp.h>
 #include <Geode/utils/casts.hpp>
@@ -221,6 +222,10 @@ static void printMods(std::ostream& stream) {
 }
 
 static LONG WINAPI exceptionHandler(LPEXCEPTION_POINTERS info) {
+    // the logs leading up to the crash may still be waiting for the log 
+    // thread, which won't get to run again
+    log::Logger::drain();
+
     // make sure crashlog directory exists
     (void)utils::file::createDirectoryAll(crashlog::getCrashLogDirectory());
 
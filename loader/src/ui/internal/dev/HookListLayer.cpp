@@ -6,8 +6,15 @@ bool HookListLayer::init(Mod* mod) {
     if (!GJDropDownLayer::init("Hooks", 220.f)) return false;
 
     auto winSize = CCDirector::sharedDirector()->getWinSize();
+    auto modHooks = mod->getHooks();
+    // if hooks are being profiled, list the ones taking the most time first
+    std::stable_sort(modHooks.begin(), modHooks.end(), [](Hook* a, Hook* b) {
+        auto timeA = a->getProfile() ? a->getProfile()->recentTimePerFrame : 0.0;
+        auto timeB = b->getProfile() ? b->getProfile()->recentTimePerFrame : 0.0;
+        return timeA > timeB;
+    });
     auto hooks = CCArray::create();
-    for (auto const& hook : mod->getHooks()) {
+    for (auto const& hook : modHooks) {
         hooks->addObject(new HookItem(hook));
     }
     m_listLayer->m_listView = HookListView::create(hooks, mod, 356.f, 220.f);
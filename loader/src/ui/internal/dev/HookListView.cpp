@@ -86,6 +86,19 @@ void HookCell::loadFromHook(Hook* hook, Mod* Mod) {
     label->setScale(.7f);
     label->setAnchorPoint({ .0f, .5f });
     m_mainLayer->addChild(label);
+
+    if (auto profile = hook->getProfile()) {
+        auto calls = profile->recentCallsPerFrame;
+        // nanoseconds to microseconds
+        auto time = profile->recentTimePerFrame / 1000.0;
+        auto profileLabel = CCLabelBMFont::create(
+            fmt::format("{:.1f} calls, {:.1f}us / frame", calls, time).c_str(), "chatFont.fnt"
+        );
+        profileLabel->setPosition(m_width - m_height * 1.5f, m_height / 2);
+        profileLabel->setScale(.5f);
+        profileLabel->setAnchorPoint({ 1.f, .5f });
+        m_mainLayer->addChild(profileLabel);
+    }
 }
 
 HookCell* HookCell::create(char const* key, CCSize size) {
@@ -8,6 +8,9 @@
 #include <Geode/utils/ranges.hpp>
 #include <Geode/utils/string.hpp>
 #include <md4c.h>
+#include <algorithm>
+#include <cctype>
+#include <list>
 
 using namespace geode::prelude;
 
@@ -16,6 +19,8 @@ static constexpr float g_paragraphPadding = 7.f;
 static constexpr float g_indent = 7.f;
 static constexpr float g_codeBlockIndent = 8.f;
 static constexpr ccColor3B g_linkColor = cc3x(0x7ff4f4);
+static constexpr unsigned g_mdFlags = MD_FLAG_UNDERLINE | MD_FLAG_STRIKETHROUGH |
+    MD_FLAG_PERMISSIVEURLAUTOLINKS | MD_FLAG_PERMISSIVEWWWAUTOLINKS;
 
 TextRenderer::Font g_mdFont = [](int style) -> TextRenderer::Label {
     if ((style & TextStyleBold) && (style & TextStyleItalic)) {
@@ -134,6 +139,7 @@ bool MDTextArea::init(std::string const& str, CCSize const& size) {
     this->addChild(m_scrollLayer);
 
     this->updateLabel();
+    this->scheduleUpdate();
 
     return true;
 }
@@ -210,6 +216,7 @@ struct MDParser {
     static float s_codeStart;
     static size_t s_orderedListNum;
     static std::vector<TextRenderer::Label> s_codeSpans;
+    static CCNode* s_target;
 
     static int parseText(MD_TEXTTYPE type, MD_CHAR const* rawText, MD_SIZE size, void* mdtextarea) {
         auto textarea = static_cast<MDTextArea*>(mdtextarea);
@@ -478,7 +485,7 @@ struct MDParser {
                     );
                     bg->setAnchorPoint({ .5f, .5f });
                     bg->setZOrder(-1);
-                    textarea->m_content->addChild(bg);
+                    s_target->addChild(bg);
 
                     renderer->popWrapOffset();
                     renderer->popIndent();
@@ -627,9 +634,169 @@ size_t MDParser::s_orderedListNum = 0;
 bool MDParser::s_isCodeBlock = false;
 float MDParser::s_codeStart = 0;
 decltype(MDParser::s_codeSpans) MDParser::s_codeSpans = {};
+CCNode* MDParser::s_target = nullptr;
 
-void MDTextArea::updateLabel() {
-    m_renderer->begin(m_content, CCPointZero, m_size);
+// how far outside the visible area blocks are kept laid out, in multiples 
+// of the text area's height
+static constexpr float g_layoutMargin = 1.f;
+// how many blocks are measured per frame after the first screen
+static constexpr size_t g_blocksMeasuredPerFrame = 4;
+
+// how many documents have their block sizes cached
+static constexpr size_t g_maxCachedDocuments = 16;
+
+struct BlockSize {
+    float offset;
+    float height;
+    float depth;
+};
+
+// block sizes of the documents that were most recently measured, by text and 
+// width, so reopening the same document doesn't need to measure it. The most 
+// recently used document is first
+static std::list<std::pair<std::string, std::vector<BlockSize>>> s_blockSizes;
+
+static bool isListItem(std::string_view line) {
+    if (line.size() >= 2 && (line[0] == '-' || line[0] == '*' || line[0] == '+')) {
+        return line[1] == ' ' || line[1] == '\t';
+    }
+    size_t i = 0;
+    while (i < line.size() && std::isdigit(static_cast<unsigned char>(line[i]))) i++;
+    return i > 0 && i + 1 < line.size() && (line[i] == '.' || line[i] == ')') &&
+        (line[i + 1] == ' ' || line[i + 1] == '\t');
+}
+
+static std::string_view trimIndent(std::string_view line, size_t max) {
+    size_t i = 0;
+    while (i < max && i < line.size() && line[i] == ' ') i++;
+    return line.substr(i);
+}
+
+static size_t countOf(std::string const& str, std::string_view what) {
+    size_t count = 0;
+    for (auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// Whether the renderer is at the start of a new line after rendering the 
+// text, which is what lets the next block start from a fresh renderer. Block 
+// types MDParser doesn't handle, like tables, leave their text on the current 
+// line for the next block to continue
+static bool endsWithLineBreak(std::string const& text) {
+    bool lineStart = true;
+
+    MD_PARSER parser;
+
+    parser.abi_version = 0;
+    parser.flags = g_mdFlags;
+
+    parser.text = [](MD_TEXTTYPE, MD_CHAR const*, MD_SIZE, void* lineStart) {
+        *static_cast<bool*>(lineStart) = false;
+        return 0;
+    };
+    parser.enter_block = [](MD_BLOCKTYPE type, void*, void* lineStart) {
+        if (type == MD_BLOCKTYPE::MD_BLOCK_HR) {
+            *static_cast<bool*>(lineStart) = true;
+        }
+        return 0;
+    };
+    parser.leave_block = [](MD_BLOCKTYPE type, void*, void* lineStart) {
+        switch (type) {
+            case MD_BLOCKTYPE::MD_BLOCK_H:
+            case MD_BLOCKTYPE::MD_BLOCK_P:
+            case MD_BLOCKTYPE::MD_BLOCK_UL:
+            case MD_BLOCKTYPE::MD_BLOCK_OL:
+            case MD_BLOCKTYPE::MD_BLOCK_LI:
+            case MD_BLOCKTYPE::MD_BLOCK_CODE:
+                *static_cast<bool*>(lineStart) = true;
+                break;
+
+            default: break;
+        }
+        return 0;
+    };
+    parser.enter_span = [](MD_SPANTYPE, void*, void*) {
+        return 0;
+    };
+    parser.leave_span = [](MD_SPANTYPE, void*, void*) {
+        return 0;
+    };
+    parser.debug_log = nullptr;
+    parser.syntax = nullptr;
+
+    if (md_parse(text.c_str(), text.size(), &parser, &lineStart)) {
+        return false;
+    }
+    return lineStart;
+}
+
+// Split the document into top-level blocks that render the same on their own 
+// as they do as part of the whole document. Splits only happen at blank lines 
+// outside of fenced code that are followed by an unindented line which can't 
+// continue a list, and after blocks that end with a line break
+static std::vector<std::string> splitBlocks(std::string const& text) {
+    std::vector<std::string> lines;
+    for (size_t pos = 0; pos <= text.size();) {
+        auto end = text.find('\n', pos);
+        if (end == std::string::npos) end = text.size();
+        lines.push_back(text.substr(pos, end - pos));
+        pos = end + 1;
+    }
+
+    // link reference definitions apply to the whole document
+    for (auto const& line : lines) {
+        auto trimmed = trimIndent(line, 3);
+        if (trimmed.starts_with("[") && trimmed.find("]:") != std::string_view::npos) {
+            return { text };
+        }
+    }
+
+    std::vector<std::string> blocks;
+    std::string current;
+    bool inFence = false;
+    bool prevBlank = false;
+    for (auto const& line : lines) {
+        auto trimmed = trimIndent(line, 3);
+        bool blank = line.find_first_not_of(" \t\r") == std::string::npos;
+        if (
+            !inFence && prevBlank && !blank && current.size() &&
+            line.front() != ' ' && line.front() != '\t' && !isListItem(line) &&
+            // color tags may span paragraphs
+            countOf(current, "<c") <= countOf(current, "</c>")
+        ) {
+            blocks.push_back(std::move(current));
+            current.clear();
+        }
+        if (trimmed.starts_with("```") || trimmed.starts_with("~~~")) {
+            inFence = !inFence;
+        }
+        prevBlank = blank;
+        current += line;
+        current += '\n';
+    }
+    if (current.find_first_not_of(" \t\r\n") != std::string::npos || blocks.empty()) {
+        blocks.push_back(std::move(current));
+    }
+
+    std::vector<std::string> joined;
+    for (auto& block : blocks) {
+        if (joined.size() && !endsWithLineBreak(joined.back())) {
+            joined.back() += block;
+        }
+        else {
+            joined.push_back(std::move(block));
+        }
+    }
+    return joined;
+}
+
+CCNode* MDTextArea::renderBlock(Block& block) {
+    // CCMenu only handles touches for its direct children, so the block is 
+    // rendered into a temporary node and its children moved over after
+    auto target = CCNode::create();
+    m_renderer->begin(target, CCPointZero, m_size);
 
     m_renderer->pushFont(g_mdFont);
     m_renderer->pushScale(.5f);
@@ -639,8 +806,7 @@ void MDTextArea::updateLabel() {
     MD_PARSER parser;
 
     parser.abi_version = 0;
-    parser.flags = MD_FLAG_UNDERLINE | MD_FLAG_STRIKETHROUGH | MD_FLAG_PERMISSIVEURLAUTOLINKS |
-        MD_FLAG_PERMISSIVEWWWAUTOLINKS;
+    parser.flags = g_mdFlags;
 
     parser.text = &MDParser::parseText;
     parser.enter_block = &MDParser::enterBlock;
@@ -651,8 +817,9 @@ void MDTextArea::updateLabel() {
     parser.syntax = nullptr;
 
     MDParser::s_codeSpans = {};
+    MDParser::s_target = target;
 
-    if (md_parse(m_text.c_str(), m_text.size(), &parser, this)) {
+    if (md_parse(block.text.c_str(), block.text.size(), &parser, this)) {
         m_renderer->renderString("Error parsing Markdown");
     }
 
@@ -668,7 +835,7 @@ void MDTextArea::updateLabel() {
         );
         bg->setAnchorPoint(render.m_node->getAnchorPoint());
         bg->setZOrder(-1);
-        m_content->addChild(bg);
+        target->addChild(bg);
         // i know what you're thinking.
         // my brother in christ, what the hell is this?
         // where did this magical + 1.5f come from?
@@ -677,11 +844,184 @@ void MDTextArea::updateLabel() {
         // OCD.
         render.m_node->setPositionY(render.m_node->getPositionY() + 1.5f);
     }
+    MDParser::s_codeSpans = {};
+    MDParser::s_target = nullptr;
+
+    // splitBlocks makes sure every block ends with a line break, so the next 
+    // block starts where the cursor is now
+    block.height = -m_renderer->getCursorPos().y;
+    m_renderer->end(false);
+    block.depth = -calculateChildCoverage(target).origin.y;
+
+    return target;
+}
+
+void MDTextArea::placeBlock(Block& block, CCNode* rendered) {
+    // blocks are placed down from the top of the content
+    auto top = m_scrollLayer->m_contentLayer->getContentSize().height - block.offset;
+    std::vector<CCNode*> children;
+    for (auto child : CCArrayExt<CCNode>(rendered->getChildren())) {
+        children.push_back(child);
+    }
+    for (auto child : children) {
+        child->retain();
+        child->removeFromParentAndCleanup(false);
+        child->setPositionY(child->getPositionY() + top);
+        m_content->addChild(child);
+        child->release();
+        block.nodes.push_back(child);
+    }
+    block.laidOut = true;
+}
+
+void MDTextArea::releaseBlock(Block& block) {
+    for (auto node : block.nodes) {
+        node->removeFromParent();
+    }
+    block.nodes.clear();
+    block.laidOut = false;
+}
+
+bool MDTextArea::isBlockNearView(Block const& block) {
+    auto layer = m_scrollLayer->m_contentLayer;
+    // position of the top of the content relative to the bottom of the 
+    // visible area
+    auto top = layer->getPositionY() + layer->getContentSize().height;
+    auto margin = m_size.height * g_layoutMargin;
+    auto blockTop = top - block.offset;
+    auto blockBottom = blockTop - std::max(block.height, block.depth);
+    return blockTop >= -margin && blockBottom <= m_size.height + margin;
+}
+
+void MDTextArea::updateVisibleBlocks() {
+    for (size_t i = 0; i < m_measuredBlocks; i++) {
+        auto& block = m_blocks[i];
+        bool visible = this->isBlockNearView(block);
+        if (visible && !block.laidOut) {
+            this->placeBlock(block, this->renderBlock(block));
+        }
+        else if (!visible && block.laidOut) {
+            this->releaseBlock(block);
+        }
+    }
+}
+
+void MDTextArea::measureNextBlock() {
+    auto& block = m_blocks[m_measuredBlocks];
+    auto rendered = this->renderBlock(block);
+    if (m_measuredBlocks) {
+        auto& prev = m_blocks[m_measuredBlocks - 1];
+        block.offset = prev.offset + prev.height;
+    }
+    else {
+        // the whole document used to be moved down by anything that sticks 
+        // out above its top
+        block.offset = calculateChildCoverage(rendered).size.height;
+    }
+    m_measuredBlocks += 1;
+    // the nodes made to measure the block are kept if they'd be laid out 
+    // anyway, and never added to the content otherwise
+    if (this->isBlockNearView(block)) {
+        this->placeBlock(block, rendered);
+    }
+}
 
-    m_renderer->end();
+float MDTextArea::getMeasuredHeight() const {
+    float height = .0f;
+    for (size_t i = 0; i < m_measuredBlocks; i++) {
+        height = std::max(height, m_blocks[i].offset + m_blocks[i].depth);
+    }
+    return height;
+}
+
+void MDTextArea::setContentHeight(float height) {
+    height = std::max(height, m_size.height);
+    auto layer = m_scrollLayer->m_contentLayer;
+    // keep the top of the content in place
+    auto diff = height - layer->getContentSize().height;
+    layer->setContentSize({ m_size.width, height });
+    layer->setPositionY(layer->getPositionY() - diff);
+    m_content->setContentSize({ m_size.width, height });
+    for (auto& block : m_blocks) {
+        for (auto node : block.nodes) {
+            node->setPositionY(node->getPositionY() + diff);
+        }
+    }
+}
+
+static std::string blockSizesKey(std::string const& text, float width) {
+    return fmt::format("{}:{}:{}", std::hash<std::string>()(text), text.size(), width);
+}
+
+void MDTextArea::update(float) {
+    if (m_measuredBlocks < m_blocks.size()) {
+        for (size_t i = 0; i < g_blocksMeasuredPerFrame && m_measuredBlocks < m_blocks.size(); i++) {
+            this->measureNextBlock();
+        }
+        this->setContentHeight(this->getMeasuredHeight());
+
+        if (m_measuredBlocks == m_blocks.size()) {
+            std::vector<BlockSize> sizes;
+            for (auto& block : m_blocks) {
+                sizes.push_back({ block.offset, block.height, block.depth });
+            }
+            auto key = blockSizesKey(m_text, m_size.width);
+            s_blockSizes.remove_if([&](auto const& pair) {
+                return pair.first == key;
+            });
+            s_blockSizes.emplace_front(std::move(key), std::move(sizes));
+            while (s_blockSizes.size() > g_maxCachedDocuments) {
+                s_blockSizes.pop_back();
+            }
+        }
+    }
+    this->updateVisibleBlocks();
+}
+
+void MDTextArea::updateLabel() {
+    for (auto& block : m_blocks) {
+        this->releaseBlock(block);
+    }
+    m_blocks.clear();
+    m_measuredBlocks = 0;
+    m_content->removeAllChildren();
+    m_content->setPosition(0.f, 0.f);
+    // start with the top of the content at the top of the text area, so the 
+    // blocks near it are known while measuring
+    m_scrollLayer->m_contentLayer->setContentSize(m_size);
+    m_scrollLayer->m_contentLayer->setPositionY(0.f);
+
+    for (auto& text : splitBlocks(m_text)) {
+        m_blocks.push_back(Block { .text = std::move(text) });
+    }
+
+    auto key = blockSizesKey(m_text, m_size.width);
+    auto cached = std::find_if(s_blockSizes.begin(), s_blockSizes.end(), [&](auto const& pair) {
+        return pair.first == key;
+    });
+    if (cached != s_blockSizes.end() && cached->second.size() == m_blocks.size()) {
+        s_blockSizes.splice(s_blockSizes.begin(), s_blockSizes, cached);
+        for (size_t i = 0; i < m_blocks.size(); i++) {
+            m_blocks[i].offset = cached->second.at(i).offset;
+            m_blocks[i].height = cached->second.at(i).height;
+            m_blocks[i].depth = cached->second.at(i).depth;
+        }
+        m_measuredBlocks = m_blocks.size();
+    }
+    else {
+        // measure enough to fill the first screen, the rest is measured 
+        // over the next frames
+        while (
+            m_measuredBlocks < m_blocks.size() &&
+            this->getMeasuredHeight() < m_size.height * (1.f + g_layoutMargin)
+        ) {
+            this->measureNextBlock();
+        }
+    }
 
-    m_scrollLayer->m_contentLayer->setContentSize(m_content->getContentSize());
+    this->setContentHeight(this->getMeasuredHeight());
     m_scrollLayer->moveToTop();
+    this->updateVisibleBlocks();
 }
 
 CCScrollLayerExt* MDTextArea::getScrollLayer() const {
@@ -2,10 +2,98 @@
 #include <Geode/utils/casts.hpp>
 #include <Geode/utils/cocos.hpp>
 #include <Geode/utils/string.hpp>
+#include <optional>
 
 using namespace geode::prelude;
 using namespace std::string_literals;
 
+namespace {
+    // Decodes the UTF-8 codepoint starting at `i` and advances `i` past it, 
+    // the same way cocos converts label strings to UTF-16
+    unsigned int nextCodepoint(std::string_view str, size_t& i) {
+        auto c = static_cast<unsigned char>(str[i++]);
+        size_t extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+        unsigned int cp = extra ? c & (0x3F >> extra) : c;
+        for (; extra && i < str.size(); extra--, i++) {
+            cp = (cp << 6) | (static_cast<unsigned char>(str[i]) & 0x3F);
+        }
+        return cp;
+    }
+
+    std::vector<std::string> splitCodepoints(std::string const& str) {
+        std::vector<std::string> res;
+        size_t i = 0;
+        while (i < str.size()) {
+            auto begin = i;
+            nextCodepoint(str, i);
+            res.push_back(str.substr(begin, i - begin));
+        }
+        return res;
+    }
+
+    // Measures text the way CCLabelBMFont::createFontChars lays it out, 
+    // straight from the font's glyph and kerning tables, so that line breaks 
+    // can be decided without calling setString on a live label
+    class BMFontMetrics {
+    protected:
+        CCBMFontConfiguration* m_config;
+
+        BMFontMetrics(CCBMFontConfiguration* config) : m_config(config) {}
+
+    public:
+        // Measurement state after some text; appending more text only needs 
+        // the state, not the text itself
+        struct Run {
+            int advance = 0;
+            int longest = 0;
+            int overhang = 0;
+            int prev = -1;
+        };
+
+        static std::optional<BMFontMetrics> from(CCNode* node) {
+            // only plain BMFont labels, subclasses may lay text out differently
+            auto label = typeinfo_cast<CCLabelBMFont*>(node);
+            if (!label || !label->getConfiguration()) {
+                return std::nullopt;
+            }
+            return BMFontMetrics(label->getConfiguration());
+        }
+
+        Run append(Run run, std::string_view text) const {
+            size_t i = 0;
+            while (i < text.size()) {
+                unsigned int key = nextCodepoint(text, i) & 0xFFFF;
+
+                tCCFontDefHashElement* element = nullptr;
+                HASH_FIND_INT(m_config->m_pFontDefDictionary, &key, element);
+                // cocos skips glyphs the font doesn't have
+                if (!element) continue;
+
+                int kerning = 0;
+                if (run.prev >= 0 && m_config->m_pKerningDictionary) {
+                    int pair = (run.prev << 16) | key;
+                    tCCKerningHashElement* kern = nullptr;
+                    HASH_FIND_INT(m_config->m_pKerningDictionary, &pair, kern);
+                    if (kern) kerning = kern->amount;
+                }
+
+                auto const& def = element->fontDef;
+                run.advance += def.xAdvance + kerning;
+                run.longest = std::max(run.longest, run.advance);
+                // the last glyph's image may extend past its advance
+                run.overhang = std::max(static_cast<int>(def.rect.size.width) - def.xAdvance, 0);
+                run.prev = key;
+            }
+            return run;
+        }
+
+        // Unscaled content width of a label containing the measured text
+        float width(Run const& run) const {
+            return (run.longest + run.overhang) / CC_CONTENT_SCALE_FACTOR();
+        }
+    };
+}
+
 bool TextDecorationWrapper::init(
     TextRenderer::Label const& label, int deco, ccColor3B const& color, GLubyte opacity
 ) {
@@ -338,6 +426,12 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
     Label label;
     bool newLine = true;
 
+    // when the font is a BMFont, words are measured from its glyph metrics 
+    // and each label only gets its string once its line is done
+    std::optional<BMFontMetrics> metrics;
+    std::string lineText;
+    BMFontMetrics::Run lineRun;
+
     auto lastIndent =
         m_indentationStack.size() > 1 ? m_indentationStack.at(m_indentationStack.size() - 1) : .0f;
 
@@ -349,7 +443,13 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
         // create label through font and add
         // decorations (underline, strikethrough) +
         // buttonize (new word just dropped)
-        label = this->addWrappers(font(style), isButton, target, callback);
+        auto raw = font(style);
+        if (res.empty()) {
+            metrics = BMFontMetrics::from(raw.m_node);
+        }
+        label = this->addWrappers(raw, isButton, target, callback);
+        lineText.clear();
+        lineRun = {};
 
         label.m_node->setScale(scale);
         label.m_node->setPosition(m_cursor);
@@ -366,7 +466,35 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
         return true;
     };
 
+    auto finishLabel = [&]() {
+        if (metrics && lineText.size()) {
+            label.m_labelProtocol->setString(lineText.c_str());
+        }
+    };
+
+    // appends the word to the current line, failing if it doesn't fit 
+    // unless forced to
+    auto renderWord = [&](std::string const& word, bool force = false) -> bool {
+        if (!metrics) {
+            if (this->render(word, label.m_node, label.m_labelProtocol)) return true;
+            if (!force) return false;
+            auto orig = label.m_labelProtocol->getString();
+            label.m_labelProtocol->setString(((orig ? orig : ""s) + word).c_str());
+            return true;
+        }
+        auto run = metrics->append(lineRun, word);
+        if (!force && m_size.width &&
+            m_cursor.x + metrics->width(run) * label.m_node->getScaleX() >
+                m_size.width - this->getCurrentWrapOffset()) {
+            return false;
+        }
+        lineText += word;
+        lineRun = run;
+        return true;
+    };
+
     auto nextLine = [&]() -> bool {
+        finishLabel();
         this->breakLine(label.m_lineHeight * scale);
         if (!createLabel()) return false;
         newLine = true;
@@ -396,7 +524,7 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
             }
 
             // try to render at the end of current line
-            if (this->render(word, label.m_node, label.m_labelProtocol)) continue;
+            if (renderWord(word)) continue;
 
             // try to create a new line
             if (!nextLine()) return {};
@@ -405,22 +533,25 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
             newLine = false;
 
             // try to render on new line
-            if (this->render(word, label.m_node, label.m_labelProtocol)) continue;
+            if (renderWord(word)) continue;
 
             // no need to create a new line as we know
             // the current one has no content and is
             // supposed to receive this one
 
             // render character by character
-            for (auto& c : word) {
-                if (!this->render(std::string(1, c), label.m_node, label.m_labelProtocol)) {
+            for (auto& c : splitCodepoints(word)) {
+                if (!renderWord(c)) {
                     if (!nextLine()) return {};
-
-                    if (utils::string::startsWith(word, " ")) word = word.substr(1);
                     newLine = false;
+
+                    // a lone character goes on the new line even if it's 
+                    // wider than the line
+                    renderWord(c, true);
                 }
             }
         }
+        finishLabel();
         // increment cursor position
         m_cursor.x += label.m_node->getScaledContentSize().width;
     }
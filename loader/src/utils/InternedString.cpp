@@ -0,0 +1,137 @@
+#include <Geode/utils/InternedString.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace geode::prelude;
+
+namespace {
+    // Open addressing hash set of interned strings. Strings are never 
+    // removed, so a slot only ever goes from null to a string once, which 
+    // lets readers probe it without a lock
+    struct Slots {
+        size_t mask;
+        std::unique_ptr<std::atomic<std::string const*>[]> slots;
+
+        explicit Slots(size_t size) :
+            mask(size - 1), slots(new std::atomic<std::string const*>[size]) {
+            for (size_t i = 0; i < size; i++) {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        size_t size() const {
+            return mask + 1;
+        }
+
+        std::string const* find(std::string_view str, size_t hash) const {
+            for (auto i = hash & mask;; i = (i + 1) & mask) {
+                auto found = slots[i].load(std::memory_order_acquire);
+                if (!found || *found == str) {
+                    return found;
+                }
+            }
+        }
+
+        // only called with InternTable::mutex held
+        void insert(std::string const* str, size_t hash) {
+            for (auto i = hash & mask;; i = (i + 1) & mask) {
+                if (!slots[i].load(std::memory_order_relaxed)) {
+                    slots[i].store(str, std::memory_order_release);
+                    return;
+                }
+            }
+        }
+    };
+
+    struct InternTable {
+        std::atomic<Slots*> current;
+        // held when adding strings, finding them doesn't need it
+        std::mutex mutex;
+        std::vector<std::unique_ptr<std::string>> strings;
+        // Slots are replaced by one twice the size when they get half full. 
+        // The old ones are kept as there may still be readers probing them
+        std::vector<std::unique_ptr<Slots>> allSlots;
+
+        InternTable() {
+            allSlots.push_back(std::make_unique<Slots>(1024));
+            current.store(allSlots.back().get(), std::memory_order_relaxed);
+        }
+
+        // Constructed on first use, so anything that interns a string while 
+        // being constructed is destroyed before the table is
+        static InternTable& get() {
+            static InternTable inst;
+            return inst;
+        }
+
+        static size_t hash(std::string_view str) {
+            return std::hash<std::string_view>()(str);
+        }
+
+        std::string const* find(std::string_view str) const {
+            return current.load(std::memory_order_acquire)->find(str, hash(str));
+        }
+
+        std::string const* intern(std::string_view str) {
+            if (auto found = this->find(str)) {
+                return found;
+            }
+            std::lock_guard _(mutex);
+            auto slots = current.load(std::memory_order_relaxed);
+            auto strHash = hash(str);
+            if (auto found = slots->find(str, strHash)) {
+                return found;
+            }
+            if ((strings.size() + 1) * 2 > slots->size()) {
+                auto grown = std::make_unique<Slots>(slots->size() * 2);
+                for (auto& owned : strings) {
+                    grown->insert(owned.get(), hash(*owned));
+                }
+                slots = grown.get();
+                allSlots.push_back(std::move(grown));
+                current.store(slots, std::memory_order_release);
+            }
+            auto ptr = strings.emplace_back(std::make_unique<std::string>(str)).get();
+            slots->insert(ptr, strHash);
+            return ptr;
+        }
+    };
+}
+
+static std::string const* intern(std::string_view str) {
+    if (str.empty()) {
+        return nullptr;
+    }
+    return InternTable::get().intern(str);
+}
+
+InternedString::InternedString(std::string_view str) : m_str(intern(str)) {}
+
+InternedString::InternedString(std::string const& str) : m_str(intern(str)) {}
+
+InternedString::InternedString(char const* str) : m_str(intern(str ? str : "")) {}
+
+std::optional<InternedString> InternedString::find(std::string_view str) {
+    if (str.empty()) {
+        return InternedString();
+    }
+    if (auto found = InternTable::get().find(str)) {
+        return InternedString(found);
+    }
+    return std::nullopt;
+}
+
+std::string const& InternedString::str() const {
+    static std::string const empty;
+    return m_str ? *m_str : empty;
+}
+
+char const* InternedString::c_str() const {
+    return this->str().c_str();
+}
+
+size_t InternedString::size() const {
+    return m_str ? m_str->size() : 0;
+}
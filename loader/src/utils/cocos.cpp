@@ -233,15 +233,40 @@ std::string geode::cocos::cc4bToHexString(ccColor4B const& color) {
     return output;
 }
 
+#include <Geode/modify/CCObject.hpp>
+
+struct WeakRefDestructor : Modify<WeakRefDestructor, CCObject> {
+    // the destructor hook, if the destructor is bound on this platform
+    static inline Hook* s_hook = nullptr;
+
+    static void onModify(auto& self) {
+        for (auto& [name, hook] : self.m_hooks) {
+            s_hook = hook;
+        }
+    }
+
+    // objects are also deleted directly and released by code inlined into 
+    // the game, so the destructor is the only place that sees every object 
+    // being freed
+    void destructor() {
+        WeakRefPool::get()->forget(this);
+        CCObject::~CCObject();
+    }
+
+    static bool isObservingDestruction() {
+        return s_hook && s_hook->isEnabled();
+    }
+};
+
 bool WeakRefController::isManaged() {
-    WeakRefPool::get()->check(m_obj);
+    if (m_retained) {
+        WeakRefPool::get()->check(m_obj);
+    }
     return m_obj;
 }
 
 void WeakRefController::swap(CCObject* other) {
-    WeakRefPool::get()->check(m_obj);
-    m_obj = other;
-    WeakRefPool::get()->check(m_obj);
+    WeakRefPool::get()->repoint(this, other);
 }
 
 CCObject* WeakRefController::get() const {
@@ -254,29 +279,108 @@ WeakRefPool* WeakRefPool::get() {
 }
 
 void WeakRefPool::check(CCObject* obj) {
-    // if this object's only reference is the WeakRefPool aka only weak 
-    // references exist to it, then release it
-    if (obj && m_pool.contains(obj) && obj->retainCount() == 1) {
-        // set delegates to null because those aren't retained!
-        if (auto input = typeinfo_cast<CCTextInputNode*>(obj)) {
-            input->m_delegate = nullptr;
+    {
+        std::lock_guard lock(m_mutex);
+        // if this object's only reference is the WeakRefPool aka only weak 
+        // references exist to it, then release it
+        auto it = m_pool.find(obj);
+        if (!obj || it == m_pool.end() || !it->second->m_retained || obj->retainCount() != 1) {
+            return;
         }
-        obj->release();
-        // log::info("nullify {}", m_pool.at(obj).get());
-        m_pool.at(obj)->m_obj = nullptr;
-        m_pool.erase(obj);
+        it->second->m_obj = nullptr;
+        m_pool.erase(it);
+        m_size = m_pool.size() + m_swapped.size();
+    }
+    // set delegates to null because those aren't retained!
+    if (auto input = typeinfo_cast<CCTextInputNode*>(obj)) {
+        input->m_delegate = nullptr;
+    }
+    // outside the lock, since releasing may destroy other objects
+    obj->release();
+}
+
+void WeakRefPool::forget(CCObject* obj) {
+    if (m_size.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    std::lock_guard lock(m_mutex);
+    if (auto it = m_pool.find(obj); it != m_pool.end()) {
+        it->second->m_obj = nullptr;
+        m_pool.erase(it);
+    }
+    if (m_swapped.size()) {
+        auto [begin, end] = m_swapped.equal_range(obj);
+        for (auto it = begin; it != end; ++it) {
+            it->second->m_obj = nullptr;
+        }
+        m_swapped.erase(begin, end);
+    }
+    m_size = m_pool.size() + m_swapped.size();
+}
+
+void WeakRefPool::repoint(WeakRefController* controller, CCObject* obj) {
+    auto shared = controller->shared_from_this();
+    CCObject* released = nullptr;
+    {
+        std::lock_guard lock(m_mutex);
+        // take the controller out of the previous object's entries
+        if (auto old = controller->m_obj.load()) {
+            if (auto it = m_pool.find(old); it != m_pool.end() && it->second == shared) {
+                m_pool.erase(it);
+            }
+            auto [begin, end] = m_swapped.equal_range(old);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second == shared) {
+                    m_swapped.erase(it);
+                    break;
+                }
+            }
+            if (controller->m_retained) {
+                released = old;
+            }
+        }
+        controller->m_obj = obj;
+        controller->m_retained = false;
+        if (obj) {
+            if (!WeakRefDestructor::isObservingDestruction()) {
+                obj->retain();
+                controller->m_retained = true;
+            }
+            // the object may already have a controller that other WeakRefs 
+            // share, and those can't be repointed to this one
+            auto& entry = m_pool[obj];
+            if (entry) {
+                m_swapped.insert({ obj, shared });
+            }
+            else {
+                entry = shared;
+            }
+        }
+        m_size = m_pool.size() + m_swapped.size();
+    }
+    if (released) {
+        released->release();
     }
 }
 
 std::shared_ptr<WeakRefController> WeakRefPool::manage(CCObject* obj) {
-    if (!m_pool.contains(obj)) {
-        CC_SAFE_RETAIN(obj);
-        auto controller = std::make_shared<WeakRefController>();
+    if (!obj) {
+        return std::make_shared<WeakRefController>();
+    }
+    std::lock_guard lock(m_mutex);
+    auto& controller = m_pool[obj];
+    if (!controller) {
+        controller = std::make_shared<WeakRefController>();
         controller->m_obj = obj;
-        m_pool.insert({ obj, controller });
+        // without the destructor hook there's no way to know when the object 
+        // is freed, so it's kept alive until only the pool references it
+        if (!WeakRefDestructor::isObservingDestruction()) {
+            obj->retain();
+            controller->m_retained = true;
+        }
     }
-    // log::info("get {} for {}", m_pool.at(obj).get(), obj);
-    return m_pool.at(obj);
+    m_size = m_pool.size() + m_swapped.size();
+    return controller;
 }
 
 CCRect geode::cocos::calculateNodeCoverage(std::vector<CCNode*> const& nodes) {
@@ -561,7 +561,7 @@ ghc::filesystem::path FileWatchEvent::getPath() const {
 }
 
 ListenerResult FileWatchFilter::handle(
-    MiniFunction<Callback> callback,
+    MiniFunctionRef<Callback> callback,
     FileWatchEvent* event
 ) {
     std::error_code ec;
@@ -586,9 +586,7 @@ Result<> file::watchFile(ghc::filesystem::path const& file) {
     auto watcher = std::make_unique<FileWatcher>(
         file,
         [](auto const& path) {
-            Loader::get()->queueInGDThread([=] {
-                FileWatchEvent(path).post();
-            });
+            postAsync(FileWatchEvent(path));
         }
     );
     if (!watcher->watching()) {
@@ -4,6 +4,11 @@
 #include <Geode/utils/web.hpp>
 #include <json.hpp>
 #include <thread>
+#include <deque>
+
+#ifndef GEODE_IS_WINDOWS
+    #include <sys/select.h>
+#endif
 
 using namespace geode::prelude;
 using namespace web;
@@ -27,6 +32,31 @@ namespace geode::utils::fetch {
     static int progress(void* ptr, double total, double now, double, double) {
         return (*as<web::FileProgressCallback*>(ptr))(now, total) != true;
     }
+
+    // DNS results and TLS sessions shared by every request, so talking to 
+    // the same servers repeatedly doesn't redo the lookups and handshakes
+    static CURLSH* sharedHandle() {
+        static std::mutex mutexes[CURL_LOCK_DATA_LAST];
+        static auto share = []() {
+            auto share = curl_share_init();
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(
+                share, CURLSHOPT_LOCKFUNC,
+                +[](CURL*, curl_lock_data data, curl_lock_access, void*) {
+                    mutexes[data].lock();
+                }
+            );
+            curl_share_setopt(
+                share, CURLSHOPT_UNLOCKFUNC,
+                +[](CURL*, curl_lock_data data, void*) {
+                    mutexes[data].unlock();
+                }
+            );
+            return share;
+        }();
+        return share;
+    }
 }
 
 Result<> web::fetchFile(
@@ -48,6 +78,7 @@ Result<> web::fetchFile(
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &file);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
+    curl_easy_setopt(curl, CURLOPT_SHARE, utils::fetch::sharedHandle());
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "github_api/1.0");
     if (prog) {
         curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0);
@@ -82,6 +113,7 @@ Result<ByteVector> web::fetchBytes(std::string const& url) {
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBytes);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "github_api/1.0");
+    curl_easy_setopt(curl, CURLOPT_SHARE, utils::fetch::sharedHandle());
     auto res = curl_easy_perform(curl);
     if (res != CURLE_OK) {
         curl_easy_cleanup(curl);
@@ -121,6 +153,7 @@ Result<std::string> web::fetch(std::string const& url) {
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeString);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "github_api/1.0");
+    curl_easy_setopt(curl, CURLOPT_SHARE, utils::fetch::sharedHandle());
     auto res = curl_easy_perform(curl);
     if (res != CURLE_OK) {
         curl_easy_cleanup(curl);
@@ -137,7 +170,7 @@ Result<std::string> web::fetch(std::string const& url) {
     return Err("Error getting info: " + std::string(curl_easy_strerror(res)));
 }
 
-class SentAsyncWebRequest::Impl {
+class SentAsyncWebRequest::Impl : public std::enable_shared_from_this<SentAsyncWebRequest::Impl> {
 private:
     enum class Status {
         Paused,
@@ -157,6 +190,7 @@ private:
     std::atomic<bool> m_cancelled = false;
     std::atomic<bool> m_finished = false;
     std::atomic<bool> m_cleanedUp = false;
+    std::atomic<bool> m_submitted = false;
     std::condition_variable m_statusCV;
     std::mutex m_statusMutex;
     SentAsyncWebRequest* m_self;
@@ -166,15 +200,27 @@ private:
         std::monostate();
     std::vector<std::string> m_httpHeaders;
 
+    // transfer state, only touched from the web thread
+    curl_slist* m_headers = nullptr;
+    // resulting byte array
+    ByteVector m_data;
+    // output file if downloading to file. unique_ptr because not always
+    // initialized but don't wanna manually managed memory
+    std::unique_ptr<std::ofstream> m_file = nullptr;
+
     template <class T>
     friend class AsyncWebResult;
     friend class AsyncWebRequest;
+    friend class WebThread;
 
     void pause();
     void resume();
     void error(std::string const& error, int code);
     void doCancel();
 
+    CURL* createHandle();
+    void finish(CURL* curl, CURLcode res);
+
 public:
     Impl(SentAsyncWebRequest* self, AsyncWebRequest const&, std::string const& id);
     void cancel();
@@ -186,131 +232,259 @@ public:
 static std::unordered_map<std::string, SentAsyncWebRequestHandle> RUNNING_REQUESTS{};
 static std::mutex RUNNING_REQUESTS_MUTEX;
 
-SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const& req, std::string const& id) :
-    m_id(id), m_url(req.m_url), m_target(req.m_target), m_httpHeaders(req.m_httpHeaders) {
-
-#define AWAIT_RESUME()    \
-    {\
-        auto lock = std::unique_lock(m_statusMutex);\
-        m_statusCV.wait(lock, [this]() { \
-            return !m_paused; \
-        });\
-        if (m_cancelled) {\
-            this->doCancel();\
-            return;\
-        }\
-    }\
+namespace geode::utils::web {
+/**
+ * Runs every async web request on a single thread through one curl multi 
+ * handle, so requests to the same host reuse connections instead of each 
+ * one spinning up a thread and a connection of its own
+ */
+class WebThread final {
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    // requests submitted from other threads
+    std::vector<std::shared_ptr<SentAsyncWebRequest::Impl>> m_submitted;
+    std::atomic_size_t m_maxConcurrent = 6;
+
+    // only touched from the web thread
+    CURLM* m_multi;
+    // requests waiting for a free slot
+    std::deque<std::shared_ptr<SentAsyncWebRequest::Impl>> m_queued;
+    std::unordered_map<CURL*, std::shared_ptr<SentAsyncWebRequest::Impl>> m_running;
+    // transfers that are done but whose request is paused
+    std::vector<std::tuple<CURL*, CURLcode, std::shared_ptr<SentAsyncWebRequest::Impl>>> m_done;
+
+    WebThread() {
+        m_multi = curl_multi_init();
+        std::thread(&WebThread::run, this).detach();
+    }
 
-    if (req.m_then) m_thens.push_back(req.m_then);
-    if (req.m_progress) m_progresses.push_back(req.m_progress);
-    if (req.m_cancelled) m_cancelleds.push_back(req.m_cancelled);
-    if (req.m_expect) m_expects.push_back(req.m_expect);
+    void run();
+    void wait();
 
-    std::thread([this]() {
-        AWAIT_RESUME();
+public:
+    static WebThread* get() {
+        static auto inst = new WebThread();
+        return inst;
+    }
 
-        auto curl = curl_easy_init();
-        if (!curl) {
-            return this->error("Curl not initialized", -1);
+    void submit(std::shared_ptr<SentAsyncWebRequest::Impl> request) {
+        {
+            std::lock_guard _(m_mutex);
+            m_submitted.push_back(std::move(request));
         }
+        m_cv.notify_one();
+    }
 
-        // resulting byte array
-        ByteVector ret;
-        // output file if downloading to file. unique_ptr because not always
-        // initialized but don't wanna manually managed memory
-        std::unique_ptr<std::ofstream> file = nullptr;
+    void setMaxConcurrent(size_t count) {
+        m_maxConcurrent = std::max<size_t>(count, 1);
+        m_cv.notify_one();
+    }
+};
 
-        // into file
-        if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
-            file = std::make_unique<std::ofstream>(
-                std::get<ghc::filesystem::path>(m_target), std::ios::out | std::ios::binary
-            );
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, file.get());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
-        }
-        // into stream
-        else if (std::holds_alternative<std::ostream*>(m_target)) {
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, std::get<std::ostream*>(m_target));
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
+void WebThread::run() {
+    while (true) {
+        {
+            std::unique_lock lock(m_mutex);
+            // sleep until there's something to do
+            m_cv.wait(lock, [this]() {
+                return !m_submitted.empty() || !m_queued.empty() || 
+                    !m_running.empty() || !m_done.empty();
+            });
+            for (auto& req : m_submitted) {
+                m_queued.push_back(std::move(req));
+            }
+            m_submitted.clear();
         }
-        // into memory
-        else {
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBytes);
+
+        // start as many requests as are allowed
+        while (!m_queued.empty() && m_running.size() < m_maxConcurrent) {
+            auto req = std::move(m_queued.front());
+            m_queued.pop_front();
+            if (req->m_cancelled) {
+                req->doCancel();
+                continue;
+            }
+            if (auto curl = req->createHandle()) {
+                curl_multi_add_handle(m_multi, curl);
+                m_running.insert({ curl, std::move(req) });
+            }
         }
-        curl_easy_setopt(curl, CURLOPT_URL, m_url.c_str());
-        // No need to verify SSL, we trust our domains :-)
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
-        // Github User Agent
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "github_api/1.0");
-        // Track progress
-        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0);
-        // Follow redirects
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
-        // Fail if response code is 4XX or 5XX
-        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
-
-        curl_slist* headers = nullptr;
-        for (auto& header : m_httpHeaders) {
-            headers = curl_slist_append(headers, header.c_str());
+
+        int running;
+        while (curl_multi_perform(m_multi, &running) == CURLM_CALL_MULTI_PERFORM);
+
+        CURLMsg* msg;
+        int left;
+        while ((msg = curl_multi_info_read(m_multi, &left))) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            auto curl = msg->easy_handle;
+            auto res = msg->data.result;
+            curl_multi_remove_handle(m_multi, curl);
+            m_done.push_back({ curl, res, std::move(m_running.at(curl)) });
+            m_running.erase(curl);
         }
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-
-        struct ProgressData {
-            SentAsyncWebRequest::Impl* self;
-            std::ofstream* file;
-        } data{this, file.get()};
-
-        curl_easy_setopt(
-            curl,
-            CURLOPT_PROGRESSFUNCTION,
-            +[](void* ptr, double total, double now, double, double) -> int {
-                auto data = static_cast<ProgressData*>(ptr);
-                auto lock = std::unique_lock(data->self->m_statusMutex);
-                data->self->m_statusCV.wait(lock, [data]() { 
-                    return !data->self->m_paused; 
-                });
-                if (data->self->m_cancelled) {
-                    if (data->file) {
-                        data->file->close();
-                    }
-                    return 1;
-                }
-                Loader::get()->queueInGDThread([self = data->self, now, total]() {
-                    std::lock_guard _(self->m_mutex);
-                    for (auto& prog : self->m_progresses) {
-                        prog(*self->m_self, now, total);
-                    }
-                });
-                return 0;
+
+        // a request is paused while another one is being joined into it, so 
+        // hold off on finishing it until then
+        std::erase_if(m_done, [](auto& done) {
+            auto& [curl, res, req] = done;
+            if (req->m_paused) {
+                return false;
             }
-        );
-        curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &data);
-        auto res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            long code = 0;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
-            curl_easy_cleanup(curl);
-            return this->error("Fetch failed: " + std::string(curl_easy_strerror(res)), code);
+            req->finish(curl, res);
+            return true;
+        });
+
+        this->wait();
+    }
+}
+
+void WebThread::wait() {
+    // the bundled curl has no way to wake up a wait from another thread, so 
+    // keep the timeout short so newly submitted requests get started quickly
+    static constexpr long MAX_WAIT_MS = 10;
+
+    if (m_running.empty()) {
+        if (!m_done.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
-        curl_easy_cleanup(curl);
+        return;
+    }
+
+    long timeout = -1;
+    curl_multi_timeout(m_multi, &timeout);
+    if (timeout < 0 || timeout > MAX_WAIT_MS) {
+        timeout = MAX_WAIT_MS;
+    }
+    if (timeout == 0) {
+        return;
+    }
 
-        AWAIT_RESUME();
+    fd_set readSet, writeSet, errorSet;
+    FD_ZERO(&readSet);
+    FD_ZERO(&writeSet);
+    FD_ZERO(&errorSet);
+    int maxfd = -1;
+    curl_multi_fdset(m_multi, &readSet, &writeSet, &errorSet, &maxfd);
+    if (maxfd == -1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        return;
+    }
+    timeval tv {
+        .tv_sec = 0,
+        .tv_usec = static_cast<decltype(tv.tv_usec)>(timeout * 1000),
+    };
+    select(maxfd + 1, &readSet, &writeSet, &errorSet, &tv);
+}
+}
 
-        // if something is still holding a handle to this
-        // request, then they may still cancel it
-        m_finished = true;
+SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const& req, std::string const& id) :
+    m_id(id), m_url(req.m_url), m_target(req.m_target), m_httpHeaders(req.m_httpHeaders) {
 
-        Loader::get()->queueInGDThread([this, ret]() {
-            std::lock_guard _(m_mutex);
-            for (auto& then : m_thens) {
-                then(*m_self, ret);
+    if (req.m_then) m_thens.push_back(req.m_then);
+    if (req.m_progress) m_progresses.push_back(req.m_progress);
+    if (req.m_cancelled) m_cancelleds.push_back(req.m_cancelled);
+    if (req.m_expect) m_expects.push_back(req.m_expect);
+}
+
+CURL* SentAsyncWebRequest::Impl::createHandle() {
+    auto curl = curl_easy_init();
+    if (!curl) {
+        this->error("Curl not initialized", -1);
+        return nullptr;
+    }
+
+    // into file
+    if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
+        m_file = std::make_unique<std::ofstream>(
+            std::get<ghc::filesystem::path>(m_target), std::ios::out | std::ios::binary
+        );
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, m_file.get());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
+    }
+    // into stream
+    else if (std::holds_alternative<std::ostream*>(m_target)) {
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, std::get<std::ostream*>(m_target));
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
+    }
+    // into memory
+    else {
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &m_data);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBytes);
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, m_url.c_str());
+    // Share DNS cache and TLS sessions
+    curl_easy_setopt(curl, CURLOPT_SHARE, utils::fetch::sharedHandle());
+    // No need to verify SSL, we trust our domains :-)
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
+    // Github User Agent
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "github_api/1.0");
+    // Track progress
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0);
+    // Follow redirects
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
+    // Fail if response code is 4XX or 5XX
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+
+    for (auto& header : m_httpHeaders) {
+        m_headers = curl_slist_append(m_headers, header.c_str());
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, m_headers);
+
+    curl_easy_setopt(
+        curl,
+        CURLOPT_PROGRESSFUNCTION,
+        +[](void* ptr, double total, double now, double, double) -> int {
+            auto self = static_cast<SentAsyncWebRequest::Impl*>(ptr);
+            // this runs on the shared web thread, so never block here
+            if (self->m_cancelled) {
+                return 1;
             }
-            std::lock_guard __(RUNNING_REQUESTS_MUTEX);
-            RUNNING_REQUESTS.erase(m_id);
-        });
-    }).detach();
+            Loader::get()->queueInGDThread([self, now, total]() {
+                std::lock_guard _(self->m_mutex);
+                for (auto& prog : self->m_progresses) {
+                    prog(*self->m_self, now, total);
+                }
+            }, Mod::get());
+            return 0;
+        }
+    );
+    curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, this);
+    return curl;
+}
+
+void SentAsyncWebRequest::Impl::finish(CURL* curl, CURLcode res) {
+    long code = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+    curl_easy_cleanup(curl);
+    curl_slist_free_all(m_headers);
+    m_headers = nullptr;
+    // close the file so it can be removed if the request was cancelled
+    m_file = nullptr;
+
+    if (m_cancelled) {
+        return this->doCancel();
+    }
+    if (res != CURLE_OK) {
+        return this->error("Fetch failed: " + std::string(curl_easy_strerror(res)), code);
+    }
+
+    // if something is still holding a handle to this
+    // request, then they may still cancel it
+    m_finished = true;
+
+    Loader::get()->queueInGDThread([this, ret = std::move(m_data)]() {
+        std::lock_guard _(m_mutex);
+        for (auto& then : m_thens) {
+            then(*m_self, ret);
+        }
+        std::lock_guard __(RUNNING_REQUESTS_MUTEX);
+        RUNNING_REQUESTS.erase(m_id);
+    }, Mod::get());
 }
 
 void SentAsyncWebRequest::Impl::doCancel() {
@@ -334,7 +508,7 @@ void SentAsyncWebRequest::Impl::doCancel() {
         for (auto& canc : m_cancelleds) {
             canc(*m_self);
         }
-    });
+    }, Mod::get());
 
     this->error("Request cancelled", -1);
 }
@@ -355,6 +529,10 @@ void SentAsyncWebRequest::Impl::pause() {
 void SentAsyncWebRequest::Impl::resume() {
     m_paused = false;
     m_statusCV.notify_all();
+    // requests start the first time they're resumed
+    if (!m_submitted.exchange(true)) {
+        WebThread::get()->submit(this->shared_from_this());
+    }
 }
 
 bool SentAsyncWebRequest::Impl::finished() const {
@@ -375,7 +553,7 @@ void SentAsyncWebRequest::Impl::error(std::string const& error, int code) {
         }
         std::lock_guard _(RUNNING_REQUESTS_MUTEX);
         RUNNING_REQUESTS.erase(m_id);
-    });
+    }, Mod::get());
 }
 
 SentAsyncWebRequest::SentAsyncWebRequest() : m_impl() {}
@@ -410,6 +588,10 @@ void SentAsyncWebRequest::error(std::string const& error, int code) {
     return m_impl->error(error, code);
 }
 
+void web::setMaxConcurrentRequests(size_t count) {
+    WebThread::get()->setMaxConcurrent(count);
+}
+
 AsyncWebRequest& AsyncWebRequest::join(std::string const& requestID) {
     m_joinID = requestID;
     return *this;